@@ -0,0 +1,233 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !PICO_ON_DEVICE
+#include <time.h>
+#endif
+
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+
+#include "game.h"
+#include "lib/sprite.h"
+#include "lib/vector.h"
+
+// Benchmark das primitivas de desenho do SSD1306. Cada carga de trabalho é repetida
+// até somar BENCH_MIN_US e o resultado sai em ns por operação. Também são medidos,
+// para uma operação partindo da tela apagada, os bytes do framebuffer alterados e
+// os bytes que o envio seguinte coloca no barramento I2C.
+//
+// No PC o I2C é o emulado pela simulação de host e o tempo vem do relógio do sistema;
+// na placa o display precisa estar ligado e o tempo vem de time_us_64.
+
+#define BENCH_MIN_US 200000
+#define BENCH_RECTS 64
+#define BENCH_LINES 16
+
+typedef struct {
+    const char *name;
+    void (*run)(ssd1306_t *ssd, uint32_t iteration);
+} bench_t;
+
+static ssd1306_t bench_ssd;
+static uint8_t rect_positions[BENCH_RECTS][2];
+
+static uint64_t bench_time_ns(void)
+{
+#if PICO_ON_DEVICE
+    return time_us_64() * 1000;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + now.tv_nsec;
+#endif
+}
+
+// Tela inteira acesa ou apagada, alternando
+static void bench_fill(ssd1306_t *ssd, uint32_t iteration)
+{
+    ssd1306_fill(ssd, !(iteration & 1));
+}
+
+// Muitos retângulos 8x8 só com a borda, como o do joystick
+static void bench_rects(ssd1306_t *ssd, uint32_t iteration)
+{
+    for (int i = 0; i < BENCH_RECTS; ++i)
+        ssd1306_rect(ssd, rect_positions[i][1], rect_positions[i][0], 8, 8, true, false);
+}
+
+// Os mesmos retângulos, preenchidos
+static void bench_rects_filled(ssd1306_t *ssd, uint32_t iteration)
+{
+    for (int i = 0; i < BENCH_RECTS; ++i)
+        ssd1306_rect(ssd, rect_positions[i][1], rect_positions[i][0], 8, 8, true, true);
+}
+
+// Sprites 8x8 em XOR nas mesmas posições, quase todas fora do alinhamento de página
+static void bench_sprites_xor(ssd1306_t *ssd, uint32_t iteration)
+{
+    static const uint8_t bitmap[] = {0x30, 0x38, 0x1E, 0x7F, 0x7F, 0x1E, 0x38, 0x30};
+    static const sprite_t sprite = {8, 8, 1, bitmap, NULL};
+
+    for (int i = 0; i < BENCH_RECTS; ++i)
+        sprite_draw(ssd, &sprite, 0, rect_positions[i][0], rect_positions[i][1], SPRITE_XOR);
+}
+
+// Diagonais longas atravessando a tela toda
+static void bench_diagonals(ssd1306_t *ssd, uint32_t iteration)
+{
+    for (int i = 0; i < BENCH_LINES; ++i)
+    {
+        uint8_t x = i * (WIDTH / BENCH_LINES);
+        ssd1306_line(ssd, x, 0, WIDTH - 1 - x, HEIGHT - 1, true);
+    }
+}
+
+// Círculos concêntricos, os maiores passando das bordas
+static void bench_circles(ssd1306_t *ssd, uint32_t iteration)
+{
+    for (int r = 4; r <= 64; r += 4)
+        vector_circle(ssd, WIDTH / 2, HEIGHT / 2, r, true);
+}
+
+// Círculo preenchido do tamanho da altura da tela
+static void bench_fill_circle(ssd1306_t *ssd, uint32_t iteration)
+{
+    vector_fill_circle(ssd, WIDTH / 2, HEIGHT / 2, HEIGHT / 2 - 1, true);
+}
+
+// Triângulos preenchidos em leque, um deles saindo da tela
+static void bench_fill_triangles(ssd1306_t *ssd, uint32_t iteration)
+{
+    for (int i = 0; i < BENCH_LINES; ++i)
+        vector_fill_triangle(ssd, WIDTH / 2, -8, i * (WIDTH / BENCH_LINES), HEIGHT - 1,
+                             (i + 1) * (WIDTH / BENCH_LINES) - 2, HEIGHT + 8, i & 1);
+}
+
+// Um único caractere
+static void bench_char(ssd1306_t *ssd, uint32_t iteration)
+{
+    ssd1306_draw_char(ssd, 'A' + iteration % 26, 8 * (iteration % 16), 8 * ((iteration / 16) % 8));
+}
+
+// Uma tela cheia de texto: 8 linhas de 16 caracteres, 128 glifos
+static void bench_text_screen(ssd1306_t *ssd, uint32_t iteration)
+{
+    static const char *const lines[] = {
+        "METEOR DODGER 01", "Time survived 42", "Life 3  Score 99", "abcdefghijklmnop",
+        "qrstuvwxyz 01234", "56789 ABCDEFGHIJ", "KLMNOPQRSTUVWXYZ", "%:Temp 25 graus ",
+    };
+
+    for (int row = 0; row < 8; ++row)
+        ssd1306_draw_string(ssd, lines[row], 0, row * 8);
+}
+
+// Campo de texto em cache com um contador: só o dígito que muda é redesenhado
+static void bench_text_cached(ssd1306_t *ssd, uint32_t iteration)
+{
+    static ssd1306_text_t text;
+    char buffer[SSD1306_TEXT_MAX];
+
+    if (iteration == 0)
+        ssd1306_text_init(&text, 0, 0);
+
+    snprintf(buffer, sizeof(buffer), "Time %lu", (unsigned long)iteration);
+    ssd1306_draw_string_cached(ssd, &text, buffer);
+}
+
+static const bench_t benches[] = {
+    {"fill", bench_fill},
+    {"rect_8x8 x64", bench_rects},
+    {"rect_8x8_filled x64", bench_rects_filled},
+    {"sprite_8x8_xor x64", bench_sprites_xor},
+    {"line_diagonal x16", bench_diagonals},
+    {"circle x16", bench_circles},
+    {"fill_circle r31", bench_fill_circle},
+    {"fill_triangle x16", bench_fill_triangles},
+    {"draw_char", bench_char},
+    {"draw_string screen x128", bench_text_screen},
+    {"draw_string_cached", bench_text_cached},
+};
+
+// Bytes do framebuffer que a primeira operação altera, partindo da tela apagada,
+// e bytes que o envio desse quadro custa no barramento.
+static void bench_measure_bytes(ssd1306_t *ssd, const bench_t *bench, size_t *changed, size_t *flushed)
+{
+    static uint8_t before[SSD1306_BUFSIZE];
+
+    ssd1306_fill(ssd, false);
+    ssd1306_send_data(ssd);
+    memcpy(before, ssd->ram_buffer, SSD1306_BUFSIZE);
+
+    bench->run(ssd, 0);
+
+    *changed = 0;
+    for (size_t i = 1; i < SSD1306_BUFSIZE; ++i)
+        *changed += ssd->ram_buffer[i] != before[i];
+
+    ssd1306_send_data(ssd);
+    *flushed = ssd->bytes_sent;
+}
+
+static void bench_run(ssd1306_t *ssd, const bench_t *bench)
+{
+    size_t changed, flushed;
+    uint32_t iterations = 0;
+    uint32_t batch = 1;
+    uint64_t elapsed_ns = 0;
+
+    bench_measure_bytes(ssd, bench, &changed, &flushed);
+
+    // Lotes crescentes para que a leitura do relógio não pese na medida
+    while (elapsed_ns < BENCH_MIN_US * 1000ull)
+    {
+        uint64_t start = bench_time_ns();
+        for (uint32_t i = 0; i < batch; ++i)
+            bench->run(ssd, iterations + i);
+        elapsed_ns += bench_time_ns() - start;
+        iterations += batch;
+        if (batch < 4096)
+            batch *= 2;
+    }
+
+    printf("%-22s %10lu %12.1f %10u %10u\n", bench->name, (unsigned long)iterations,
+           (double)elapsed_ns / iterations, (unsigned)changed, (unsigned)flushed);
+}
+
+int main(void)
+{
+    stdio_init_all();
+
+#if PICO_ON_DEVICE
+    sleep_ms(2000); // Tempo para o terminal USB conectar
+
+    i2c_init(I2C_PORT, 400 * 1000);
+    gpio_set_function(I2C_SDA, GPIO_FUNC_I2C);
+    gpio_set_function(I2C_SCL, GPIO_FUNC_I2C);
+    gpio_pull_up(I2C_SDA);
+    gpio_pull_up(I2C_SCL);
+#endif
+
+    ssd1306_init(&bench_ssd, WIDTH, HEIGHT, false, I2C_ADDRESS, I2C_PORT);
+    ssd1306_config(&bench_ssd);
+
+    // Posições fixas para que as execuções sejam comparáveis
+    srand(1);
+    for (int i = 0; i < BENCH_RECTS; ++i)
+    {
+        rect_positions[i][0] = rand() % (WIDTH - 8);
+        rect_positions[i][1] = rand() % (HEIGHT - 8);
+    }
+
+    printf("%-22s %10s %12s %10s %10s\n", "primitiva", "operacoes", "ns/op", "bytes_fb", "bytes_i2c");
+    for (size_t i = 0; i < sizeof(benches) / sizeof(benches[0]); ++i)
+        bench_run(&bench_ssd, &benches[i]);
+
+#if PICO_ON_DEVICE
+    while (true)
+        tight_loop_contents();
+#endif
+
+    return 0;
+}
@@ -0,0 +1,533 @@
+#include <stdio.h>
+
+#include "pico/stdlib.h"
+#include "pico/bootrom.h"
+
+#include "game.h"
+#include "lib/scheduler.h"
+#include "lib/joystick.h"
+#include "lib/profiler.h"
+#include "lib/log_ring.h"
+#include "lib/input.h"
+#include "lib/sprite.h"
+#include "lib/audio.h"
+
+// Variáveis globais
+int8_t spaceship_x = SPACESHIP_START_X; // Coluna da nave, na linha de baixo da matriz
+struct repeating_timer red_led_timer; // Timer para piscar o LED vermelho
+bool red_led_timer_active = false; // Variável de controle do timer
+static bool game_started = false; // Variável de controle do jogo
+static uint32_t start_time = 0;
+static uint32_t elapsed_seconds = 0;
+static uint32_t last_input_us = 0; // Instante do último botão que mudou o jogo
+ssd1306_t ssd; // Estrutura do display
+rect_t rect; // Retângulo controlado pelo joystick
+meteor_field_t meteors; // Meteoros em queda
+static uint8_t spawn_countdown = 0; // Passos até o próximo meteoro
+static int8_t life = 3; // Vida do jogador
+frame_queue_t frame_queue; // Quadros do núcleo 0 para o núcleo 1
+static int input_task, tick_task, publish_task, log_task, idle_task; // Tarefas trocadas pelo modo ocioso
+static bool idle = false; // Modo ocioso
+static uint32_t last_activity_us = 0; // Última entrada ou passo com o jogo rodando
+static uint32_t wake_us = 0; // Instante do último despertar
+
+static void idle_enter(void);
+static void idle_exit(uint32_t since_us);
+
+// Nave do display, 8x8 em formato de páginas; o segundo quadro estica a chama
+static const uint8_t ship_bitmap[] = {
+    0x30, 0x38, 0x1E, 0x7F, 0x7F, 0x1E, 0x38, 0x30,
+    0x30, 0x38, 0x1E, 0xFF, 0xFF, 0x1E, 0x38, 0x30,
+};
+static const sprite_t ship_sprite = {8, 8, 2, ship_bitmap, NULL};
+_Static_assert(RECT_SIZE == 8, "o retângulo do display é a nave 8x8");
+
+// Sons do jogo, tocados pelo sequenciador sem travar as tarefas
+static const audio_note_t start_sound[] = {{523, 80}, {659, 80}, {784, 120}};
+static const audio_note_t hit_sound[] = {{300, 120}, {0, 30}, {220, 150}, {150, 200}};
+static const audio_note_t game_over_sound[] = {{392, 200}, {330, 200}, {262, 200}, {196, 400}};
+
+// Prepara o estado do jogo antes das tarefas começarem
+void game_init(void)
+{
+    init_rectangle(&rect, (DISPLAY_WIDTH - RECT_SIZE) / 2, (DISPLAY_HEIGHT - RECT_SIZE) / 2, RECT_SIZE, RECT_SIZE);
+    frame_queue_init(&frame_queue);
+    meteor_field_init(&meteors);
+
+    // Cada etapa estoura quando passa do período da tarefa que a dispara
+    profile_set_budget(PROFILE_INPUT, INPUT_PERIOD_US);
+    profile_set_budget(PROFILE_GAME_TICK, GAME_TICK_US);
+    profile_set_budget(PROFILE_PUBLISH, FRAME_PERIOD_US);
+    profile_set_budget(PROFILE_OLED_DRAW, FRAME_PERIOD_US);
+    profile_set_budget(PROFILE_OLED_FLUSH, FRAME_PERIOD_US);
+    profile_set_budget(PROFILE_MATRIX, FRAME_PERIOD_US);
+    profile_set_budget(PROFILE_FRAME, FRAME_PERIOD_US);
+    profile_set_budget(PROFILE_INPUT_LATENCY, INPUT_DEBOUNCE_US + INPUT_PERIOD_US + FRAME_PERIOD_US);
+    profile_set_budget(PROFILE_WAKE_LATENCY, IDLE_WAKE_BUDGET_US);
+}
+
+// Tarefas do jogo em andamento; o modo ocioso as cancela e as registra de novo ao acordar
+static void game_add_tasks(void)
+{
+    input_task = scheduler_add_periodic(task_input, NULL, INPUT_PERIOD_US);
+    tick_task = scheduler_add_periodic(task_game_tick, NULL, GAME_TICK_US);
+    publish_task = scheduler_add_periodic(task_publish_frame, NULL, FRAME_PERIOD_US);
+    log_task = scheduler_add_periodic(task_log_drain, NULL, LOG_DRAIN_PERIOD_US);
+    last_activity_us = time_us_32();
+}
+
+// Registra as tarefas do jogo. Cada etapa roda no seu próprio ritmo; nenhuma delas dorme.
+void game_start_tasks(void)
+{
+    game_add_tasks();
+#if PROFILE_ENABLED
+    scheduler_add_periodic(task_profile, NULL, PROFILE_POLL_US);
+#endif
+}
+
+// Tarefa de registro: imprime o que as interrupções e os dois núcleos registraram.
+// As mensagens saem daqui, nunca de dentro de uma interrupção.
+void task_log_drain(void *arg)
+{
+    log_drain();
+}
+
+// Entra no modo ocioso: troca as tarefas do jogo por uma verificação lenta dos botões e do
+// joystick e por um quadro por IDLE_FRAME_PERIOD_US. Entre elas os dois núcleos dormem em __wfe.
+static void idle_enter(void)
+{
+    idle = true;
+    scheduler_cancel(input_task);
+    scheduler_cancel(tick_task);
+    scheduler_cancel(publish_task);
+    scheduler_cancel(log_task);
+    publish_task = scheduler_add_periodic(task_publish_frame, NULL, IDLE_FRAME_PERIOD_US);
+    idle_task = scheduler_add_periodic(task_idle, NULL, IDLE_POLL_US);
+    joystick_set_sample_rate(IDLE_JOYSTICK_RATE_HZ); // Menos conversões e transferências de DMA
+    LOG0("Idle");
+    task_publish_frame(NULL); // O núcleo 1 escurece o display e apaga a matriz já
+}
+
+// Sai do modo ocioso e desenha o primeiro quadro sem esperar o período
+static void idle_exit(uint32_t since_us)
+{
+    idle = false;
+    wake_us = since_us;
+    scheduler_cancel(idle_task);
+    scheduler_cancel(publish_task);
+    joystick_set_sample_rate(JOYSTICK_SAMPLE_RATE_HZ);
+    game_add_tasks();
+    LOG0("Wake");
+    task_input(NULL); // Aplica o botão que acordou a placa
+    task_publish_frame(NULL);
+}
+
+// Tarefa do modo ocioso: um evento na fila ou o joystick fora do centro acordam a placa.
+// O evento fica na fila para task_input aplicá-lo.
+void task_idle(void *arg)
+{
+    input_event_t event;
+    uint16_t x, y;
+
+    log_drain();
+    if (input_peek(&event)) {
+        idle_exit(event.timestamp_us);
+        return;
+    }
+
+    read_joystick_xy_values(&x, &y);
+    if (x != JOYSTICK_ADC_CENTER || y != JOYSTICK_ADC_CENTER) {
+        idle_exit(time_us_32());
+    }
+}
+
+#if PROFILE_ENABLED
+// Tarefa de diagnóstico: imprime os histogramas com 'p' na serial ou com os botões A e B
+// pressionados juntos; 'r' zera as medidas.
+void task_profile(void *arg)
+{
+    static bool chord_held = false;
+    int c = getchar_timeout_us(0);
+
+    if (c == 'p') {
+        profile_dump();
+    } else if (c == 'r') {
+        profile_reset();
+    }
+
+    bool chord = !gpio_get(BTN_A_PIN) && !gpio_get(BTN_B_PIN);
+    if (chord && !chord_held) {
+        profile_dump();
+    }
+    chord_held = chord;
+}
+#endif
+
+// Tarefa de entrada: aplica os eventos dos botões, lê o joystick e move o retângulo.
+// É o único ponto em que o estado do jogo muda por causa da entrada.
+void task_input(void *arg)
+{
+    uint16_t vrx_value_raw; // Valor bruto do eixo X
+    uint16_t vry_value_raw; // Valor bruto do eixo Y
+    input_event_t event;
+    bool active = game_started;
+    PROFILE_BEGIN(PROFILE_INPUT);
+
+    while (input_poll(&event)) {
+        active = true;
+        if (event.pressed) {
+            handle_button_press(&event);
+        }
+    }
+
+    // Lê os valores do joystick
+    read_joystick_xy_values(&vrx_value_raw, &vry_value_raw);
+    vry_value_raw = ADC_MAX_VALUE - vry_value_raw; // Inverte o eixo Y
+
+    // Calcula o delta a partir do centro
+    int delta_x = get_rect_delta_x(&rect, vrx_value_raw, RECT_SPEED_DIVIDER);
+    int delta_y = get_rect_delta_y(&rect, vry_value_raw, RECT_SPEED_DIVIDER);
+
+    // Atualiza a posição do retângulo
+    set_rectangle_position(&rect, rect.x + delta_x, rect.y + delta_y);
+    PROFILE_END(PROFILE_INPUT);
+
+    // Parado e sem entrada por IDLE_TIMEOUT_US: entra no modo ocioso
+    uint32_t now = time_us_32();
+    if (active || delta_x != 0 || delta_y != 0) {
+        last_activity_us = now;
+    } else if (now - last_activity_us >= IDLE_TIMEOUT_US) {
+        idle_enter();
+    }
+}
+
+// Tarefa de publicação: envia ao núcleo 1 uma cópia do estado a desenhar
+void task_publish_frame(void *arg)
+{
+    static uint32_t sequence = 0;
+    PROFILE_BEGIN(PROFILE_PUBLISH);
+    frame_t frame = {
+        .sequence = ++sequence,
+        .published_us = time_us_32(),
+        .input_us = last_input_us,
+        .rect_x = rect.x,
+        .rect_y = rect.y,
+        .rect_width = rect.width,
+        .rect_height = rect.height,
+        .matrix_update = game_started || idle,
+        .idle = idle,
+        .wake_us = wake_us,
+        .spaceship_x = spaceship_x,
+        .explosions = meteors.explosions,
+    };
+
+    for (int speed = 0; speed < METEOR_SPEEDS; ++speed) {
+        frame.meteors[speed] = meteors.layers[speed];
+    }
+
+    frame_queue_push(&frame_queue, &frame); // Com a fila cheia o quadro é descartado e contado
+    PROFILE_END(PROFILE_PUBLISH);
+}
+
+// Desenha o display OLED a partir da descrição do quadro
+void render_oled(const frame_t *frame)
+{
+    static bool dimmed = false;
+
+    if (frame->idle != dimmed) {
+        ssd1306_set_contrast(&ssd, frame->idle ? IDLE_CONTRAST : DISPLAY_CONTRAST);
+        dimmed = frame->idle;
+    }
+
+    ssd1306_fill(&ssd, false);
+    sprite_draw(&ssd, &ship_sprite, (frame->sequence >> 2) & 1, frame->rect_x, frame->rect_y, SPRITE_SET); // Chama alterna a cada 4 quadros
+    ssd1306_send_data_async(&ssd); // Envia os dados para o display sem bloquear
+}
+
+// Compõe a matriz de LEDs a partir da descrição do quadro
+ws2812b_frame_t render_matrix(const frame_t *frame)
+{
+    static const uint8_t meteor_red[METEOR_SPEEDS] = {186, 119}; // Meteoros lentos mais fracos: ~3/8 do brilho após a gama
+    static bool suspended = false;
+
+    // No modo ocioso a matriz apaga uma vez e fica parada até o próximo quadro normal
+    if (frame->idle) {
+        if (!suspended) {
+            ws2812b_suspend();
+            suspended = true;
+        }
+        return ws2812b_last_frame();
+    }
+    if (suspended) {
+        ws2812b_resume();
+        suspended = false;
+    }
+
+    ws2812b_clear();
+    for (int speed = METEOR_SPEEDS - 1; speed >= 0; --speed) {
+        for (int bit = bitboard_next(&frame->meteors[speed], 0); bit >= 0; bit = bitboard_next(&frame->meteors[speed], bit + 1)) {
+            ws2812b_set_led_xy(bit % BITBOARD_WIDTH, bit / BITBOARD_WIDTH, meteor_red[speed], 0, 0); // Meteoro
+        }
+    }
+    ws2812b_set_led_xy(frame->spaceship_x, 0, 0, 0, 186); // Nave
+    for (int bit = bitboard_next(&frame->explosions, 0); bit >= 0; bit = bitboard_next(&frame->explosions, bit + 1)) {
+        ws2812b_set_led_xy(bit % BITBOARD_WIDTH, bit / BITBOARD_WIDTH, 186, 186, 0); // Exibe uma explosão
+    }
+
+    return ws2812b_present(); // Quadros iguais ao anterior não são transmitidos
+}
+
+// Uma iteração do núcleo de renderização: consome os quadros publicados e cuida dos
+// barramentos do display e da matriz. Cada saída desenha o quadro mais recente assim
+// que termina o envio anterior. Retorna false quando não há nada pendente.
+bool render_poll(void)
+{
+    static frame_t frame;
+    static bool oled_pending = false;
+    static bool matrix_pending = false;
+    static ws2812b_frame_t matrix_frame = 0;
+#if PROFILE_ENABLED
+    static bool oled_in_flight = false;
+    static uint32_t oled_started_us, oled_published_us, oled_wake_us;
+    static uint32_t wake_recorded_us = 0;
+
+    if (oled_in_flight && !ssd1306_is_busy(&ssd)) {
+        uint32_t now = time_us_32();
+        profile_record(PROFILE_OLED_FLUSH, now - oled_started_us);
+        profile_record(PROFILE_FRAME, now - oled_published_us);
+        // Latência do despertar até o display mostrar o primeiro quadro normal
+        if (oled_wake_us != wake_recorded_us) {
+            profile_record(PROFILE_WAKE_LATENCY, now - oled_wake_us);
+            wake_recorded_us = oled_wake_us;
+        }
+        oled_in_flight = false;
+    }
+#endif
+
+    if (frame_queue_pop_latest(&frame_queue, &frame)) {
+        oled_pending = true;
+        matrix_pending = frame.matrix_update;
+    }
+
+    if (oled_pending && !ssd1306_is_busy(&ssd)) {
+        PROFILE_BEGIN(PROFILE_OLED_DRAW);
+        render_oled(&frame);
+        PROFILE_END(PROFILE_OLED_DRAW);
+#if PROFILE_ENABLED
+        oled_started_us = time_us_32();
+        oled_published_us = frame.published_us;
+        oled_wake_us = frame.wake_us;
+        oled_in_flight = true;
+#endif
+        oled_pending = false;
+    }
+
+    if (matrix_pending && ws2812b_is_done(matrix_frame)) {
+        PROFILE_BEGIN(PROFILE_MATRIX);
+        matrix_frame = render_matrix(&frame);
+        PROFILE_END(PROFILE_MATRIX);
+        matrix_pending = false;
+
+#if PROFILE_ENABLED
+        // Latência do botão até a matriz começar a exibir o resultado
+        static uint32_t input_recorded_us = 0;
+        if (frame.input_us != input_recorded_us) {
+            profile_record(PROFILE_INPUT_LATENCY, time_us_32() - frame.input_us);
+            input_recorded_us = frame.input_us;
+        }
+#endif
+    }
+
+    return oled_pending || matrix_pending;
+}
+
+// Passo fixo da lógica do jogo, medido como uma etapa
+void task_game_tick(void *arg)
+{
+    PROFILE_BEGIN(PROFILE_GAME_TICK);
+    game_tick();
+    PROFILE_END(PROFILE_GAME_TICK);
+}
+
+// Meteoros, colisão e vidas. Nada é impresso por passo; só as mudanças de estado.
+void game_tick(void)
+{
+    if (!game_started) {
+        return;
+    }
+
+    update_elapsed_time(); // Atualiza o tempo decorrido
+
+    // Novos meteoros entram no topo em intervalos aleatórios, cada um com sua velocidade
+    if (spawn_countdown == 0) {
+        spawn_meteor();
+        spawn_countdown = random_number(METEOR_SPAWN_MIN_TICKS, METEOR_SPAWN_MAX_TICKS);
+    }
+    spawn_countdown--;
+
+    // Colisão com a nave: um AND entre o campo e a célula da nave
+    bitboard_t spaceship;
+    bitboard_clear(&spaceship);
+    bitboard_set(&spaceship, spaceship_x, 0);
+
+    uint hits = meteor_collide(&meteors, &spaceship);
+    if (hits) {
+        life = MAX(life - (int)hits, 0); // Duas classes podem acertar no mesmo passo
+        LOG1("Meteor hit! Life: %d", life);
+
+        audio_play(hit_sound, count_of(hit_sound)); // Só enfileira; o alarme do sequenciador toca
+    }
+
+    signal_life_status(life);
+
+    // Cada classe de velocidade desce quando vence o seu período
+    meteor_step(&meteors);
+
+    // Game over
+    if (life <= 0) {
+        game_started = false;
+        meteor_field_clear(&meteors);
+        spawn_countdown = 0;
+        life = 3; // Reseta a vida
+        spaceship_x = SPACESHIP_START_X; // Reseta a nave para o meio
+        audio_stop(); // O som de game over corta o da colisão
+        audio_play(game_over_sound, count_of(game_over_sound));
+        LOG0("Game Over");
+        LOG1("Time survived: %d", elapsed_seconds);
+    }
+}
+
+// Cria um meteoro em uma coluna livre do topo, escolhida ao acaso, com velocidade aleatória
+void spawn_meteor(void) {
+    uint32_t free_columns = meteor_spawn_columns(&meteors);
+    int free_count = __builtin_popcount(free_columns);
+
+    if (free_count == 0) {
+        return;
+    }
+
+    // Pula até a n-ésima coluna livre
+    for (int n = random_number(0, free_count - 1); n > 0; --n) {
+        free_columns &= free_columns - 1;
+    }
+    meteor_spawn(&meteors, __builtin_ctz(free_columns), random_number(0, METEOR_SPEEDS - 1));
+}
+
+// Lê os valores X e Y do joystick, já filtrados pela amostragem em segundo plano
+void read_joystick_xy_values(uint16_t *x_value, uint16_t *y_value)
+{
+    joystick_read(x_value, y_value);
+}
+
+// Calcula o delta X retângulo a partir dos valores do joystick
+int get_rect_delta_x(rect_t *rect, int vrx_value, int speed) {
+    // Calcula o delta a partir do centro
+    int delta_x = (vrx_value - ADC_HALF_VALUE) / speed;
+
+    if (rect->x + delta_x < 0) {
+        delta_x = -rect->x;
+    } else if (rect->x + delta_x > DISPLAY_WIDTH - rect->width) {
+        delta_x = DISPLAY_WIDTH - rect->width - rect->x;
+    }
+
+    return delta_x;
+}
+
+// Calcula o delta Y retângulo a partir dos valores do joystick
+int get_rect_delta_y(rect_t *rect, int vry_value, int speed) {
+    // Calcula o delta a partir do centro
+    int delta_y = (vry_value - ADC_HALF_VALUE) / speed;
+
+    if (rect->y + delta_y < 0) {
+        delta_y = -rect->y;
+    } else if (rect->y + delta_y > DISPLAY_HEIGHT - rect->height) {
+        delta_y = DISPLAY_HEIGHT - rect->height - rect->y;
+    }
+
+    return delta_y;
+}
+
+// Gera número aleatório entre min e max (inclusive)
+int random_number(int min, int max) {
+    return min + (rand() % (max - min + 1));
+}
+
+// Aplica o aperto de um botão, já sem trepidação
+void handle_button_press(const input_event_t *event) {
+    if (event->pin == BTN_A_PIN || event->pin == BTN_B_PIN) {
+        last_input_us = event->timestamp_us;
+
+        if (!game_started) {
+            game_started = true;
+            start_time = time_us_32(); // Marca o tempo de início do jogo
+            elapsed_seconds = 0; // Reseta o tempo decorrido
+            spaceship_x = SPACESHIP_START_X; // Reseta a nave para o meio
+            audio_play(start_sound, count_of(start_sound));
+            LOG0("Game started");
+        } else if (event->pin == BTN_A_PIN) {
+            if (spaceship_x < BITBOARD_WIDTH - 1) {
+                spaceship_x++;
+            }
+        } else if (spaceship_x > 0) {
+            spaceship_x--;
+        }
+
+    } else if (event->pin == SW_PIN) {
+        LOG0("SW pressed");
+        reset_usb_boot(0, 0);
+    }
+}
+
+// Função Callback para piscar o LED
+bool blink_red_led_callback(struct repeating_timer *t) {
+    gpio_put(RED_LED_PIN, !gpio_get(RED_LED_PIN));
+    LOG0("Blinking red LED");
+
+    return true; // Retorna true para continuar repetindo
+}
+
+// Função para sinalizar o status da vida
+// 3 vidas: Verde, 2 vidas: Azul, 1 vida: Pisca vermelho, 0 vidas: Vermelho fixo
+void signal_life_status(int8_t life) {
+    switch(life) {
+        case 3:
+            gpio_put(GREEN_LED_PIN, 1);  // Verde significa vida cheia
+            gpio_put(RED_LED_PIN, 0);
+            gpio_put(BLUE_LED_PIN, 0);
+            break;
+        case 2:
+            gpio_put(BLUE_LED_PIN, 1);   // Azul significa 2 vidas
+            gpio_put(GREEN_LED_PIN, 0);
+            gpio_put(RED_LED_PIN, 0);
+            break;
+        case 1:
+            gpio_put(BLUE_LED_PIN, 0);
+            gpio_put(GREEN_LED_PIN, 0);
+
+            if (!red_led_timer_active) {
+                add_repeating_timer_ms(-250, blink_red_led_callback, NULL, &red_led_timer); // Pisca vermelho 3x quando só tem 1 vida
+                red_led_timer_active = true;
+            }
+
+            break;
+        case 0:
+            if (red_led_timer_active) {
+                cancel_repeating_timer(&red_led_timer);
+                red_led_timer_active = false;
+            }
+            gpio_put(BLUE_LED_PIN, 0);       // Chega aqui também direto de 2 vidas
+            gpio_put(GREEN_LED_PIN, 0);
+            gpio_put(RED_LED_PIN, 1);        // Vermelho fixo significa game over
+
+            break;
+    }
+}
+
+// Atualiza o tempo decorrido desde o início do jogo
+void update_elapsed_time(void) {
+    uint32_t current_time = time_us_32();
+    uint32_t diff = current_time - start_time;
+
+    // Converte microssegundos para segundos
+    elapsed_seconds = diff / 1000000;
+}
@@ -0,0 +1,91 @@
+#ifndef GAME_H
+#define GAME_H
+
+#include "pico/stdlib.h"
+
+#include "lib/ssd1306.h"
+#include "lib/ws2812b.h"
+#include "lib/rectangle.h"
+#include "lib/frame_queue.h"
+#include "lib/input.h"
+#include "lib/meteors.h"
+
+// Variáveis de configuração
+#define I2C_PORT i2c1
+#define I2C_SDA 14
+#define I2C_SCL 15
+#define I2C_ADDRESS 0x3C
+#define LED_MATRIX_PIN 7
+#define GREEN_LED_PIN 11
+#define BLUE_LED_PIN 12
+#define RED_LED_PIN 13
+#define BTN_A_PIN 5
+#define BTN_B_PIN 6
+#define BUZZER_A_PIN 21
+#define VRX_PIN 27
+#define VRY_PIN 26
+#define SW_PIN 22
+#define ADC_MAX_VALUE 4096
+#define ADC_HALF_VALUE 2048
+#define DISPLAY_WIDTH SSD1306_WIDTH
+#define DISPLAY_HEIGHT SSD1306_HEIGHT
+#define RECT_SIZE 8
+#define JOYSTICK_SAMPLE_RATE_HZ 4000 // Conversões por segundo, somando os dois eixos
+#define JOYSTICK_OVERSAMPLING 16     // Amostras de cada eixo por leitura
+#define JOYSTICK_FILTER_SHIFT 2      // Filtro IIR com peso 1/4 para a leitura nova
+#define JOYSTICK_DEAD_ZONE 64        // Zona morta em torno do centro
+
+// Meteoros
+#define METEOR_SPAWN_MIN_TICKS 2 // Passos do jogo entre dois meteoros novos, no mínimo
+#define METEOR_SPAWN_MAX_TICKS 5 // e no máximo
+#define SPACESHIP_START_X (LED_MATRIX_LOGICAL_WIDTH / 2) // Coluna inicial da nave
+
+// Ritmo de cada tarefa do escalonador
+#define INPUT_PERIOD_US 50000    // Leitura do joystick
+#define GAME_TICK_US 150000      // Passo fixo da lógica do jogo
+#define FRAME_PERIOD_US 33000    // Publicação de quadros para o núcleo 1 (~30 Hz)
+#define RECT_SPEED_DIVIDER 240   // Divisor do deslocamento do retângulo a cada leitura
+#define LOG_DRAIN_PERIOD_US 20000 // Impressão dos registros adiados
+#define PROFILE_POLL_US 100000   // Consulta do pedido de dump das medidas (serial ou A+B)
+
+// Modo ocioso: com o jogo parado e sem entrada, as tarefas do jogo param, o display perde
+// contraste e só é redesenhado pelo timer lento, e a matriz apaga. Botão ou joystick acordam.
+#define IDLE_TIMEOUT_US 20000000     // Tempo parado até entrar no modo ocioso
+#define IDLE_POLL_US 50000           // Verificação dos botões e do joystick no modo ocioso
+#define IDLE_FRAME_PERIOD_US 1000000 // Atualização do display no modo ocioso
+#define IDLE_JOYSTICK_RATE_HZ 1000   // Conversões por segundo do joystick no modo ocioso (>= JOYSTICK_MIN_SAMPLE_RATE_HZ)
+#define IDLE_CONTRAST 0x08           // Contraste do display no modo ocioso
+#define DISPLAY_CONTRAST 0xFF        // Contraste normal, o mesmo de ssd1306_config
+// Pior caso do despertar até o display: trepidação, uma verificação e o envio de um quadro
+#define IDLE_WAKE_BUDGET_US (INPUT_DEBOUNCE_US + IDLE_POLL_US + FRAME_PERIOD_US)
+
+void game_init(void);
+void game_start_tasks(void);
+bool render_poll(void);
+void read_joystick_xy_values(uint16_t *x_value, uint16_t *y_value);
+int get_rect_delta_x(rect_t *rect, int vrx_value, int speed);
+int get_rect_delta_y(rect_t *rect, int vry_value, int speed);
+int random_number(int min, int max);
+void handle_button_press(const input_event_t *event);
+bool blink_red_led_callback(struct repeating_timer *t);
+void signal_life_status(int8_t life);
+void update_elapsed_time(void);
+void task_input(void *arg);
+void task_game_tick(void *arg);
+void game_tick(void);
+void spawn_meteor(void);
+void task_publish_frame(void *arg);
+void render_oled(const frame_t *frame);
+ws2812b_frame_t render_matrix(const frame_t *frame);
+void task_profile(void *arg);
+void task_log_drain(void *arg);
+void task_idle(void *arg);
+
+// Estado compartilhado com a inicialização da placa e com a simulação de host
+extern ssd1306_t ssd;
+extern rect_t rect;
+extern frame_queue_t frame_queue;
+extern int8_t spaceship_x;
+extern meteor_field_t meteors;
+
+#endif // GAME_H
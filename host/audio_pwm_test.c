@@ -0,0 +1,73 @@
+#include <stdio.h>
+
+#include "pico/stdlib.h"
+
+#include "audio.h"
+
+// Teste do cálculo de divisor e wrap do PWM do buzzer com o clock de 125 MHz: o wrap
+// cabe em 16 bits, o divisor fica entre 1.0 e 255 + 15/16 e a frequência gerada fica a
+// menos de 0,1% da pedida. A frequência é inteira, então o piso de 7,5 Hz é conferido
+// dos dois lados: 8 Hz ainda cabe no divisor máximo e 7 Hz é recusado.
+
+#define TEST_CLOCK_HZ 125000000u
+
+static int failures = 0;
+
+// Frequência que o PWM gera com o divisor e o wrap calculados.
+static double generated_hz(uint32_t clock_hz, const audio_pwm_t *pwm)
+{
+    return clock_hz * 16.0 / ((double)pwm->divider_16 * ((uint32_t)pwm->wrap + 1));
+}
+
+static void check_frequency(uint32_t clock_hz, uint32_t frequency_hz)
+{
+    audio_pwm_t pwm;
+
+    if (!audio_pwm_compute(clock_hz, frequency_hz, &pwm))
+    {
+        printf("%u Hz: recusada\n", (unsigned)frequency_hz);
+        failures++;
+        return;
+    }
+
+    double error = generated_hz(clock_hz, &pwm) / frequency_hz - 1.0;
+    if (pwm.divider_16 < 16 || pwm.divider_16 > 0xFFF || error > 0.001 || error < -0.001)
+    {
+        printf("%u Hz: divisor %u + %u/16, wrap %u, gera %.3f Hz\n", (unsigned)frequency_hz,
+               pwm.divider_16 >> 4, pwm.divider_16 & 0xF, pwm.wrap, generated_hz(clock_hz, &pwm));
+        failures++;
+    }
+}
+
+static void check_rejected(uint32_t clock_hz, uint32_t frequency_hz)
+{
+    audio_pwm_t pwm;
+
+    if (audio_pwm_compute(clock_hz, frequency_hz, &pwm))
+    {
+        printf("%u Hz: aceita fora do alcance (divisor %u + %u/16, wrap %u)\n", (unsigned)frequency_hz,
+               pwm.divider_16 >> 4, pwm.divider_16 & 0xF, pwm.wrap);
+        failures++;
+    }
+}
+
+int main(void)
+{
+    // Pontos pedidos: piso, notas do jogo e o teto de metade do clock
+    check_frequency(TEST_CLOCK_HZ, 8);
+    check_frequency(TEST_CLOCK_HZ, 300);
+    check_frequency(TEST_CLOCK_HZ, 1900);
+    check_frequency(TEST_CLOCK_HZ, TEST_CLOCK_HZ / 2);
+
+    // Toda a faixa audível, Hz a Hz
+    for (uint32_t frequency_hz = 8; frequency_hz <= 20000; ++frequency_hz)
+        check_frequency(TEST_CLOCK_HZ, frequency_hz);
+
+    // Abaixo de 7,5 Hz o divisor não alcança; acima de metade do clock não há onda
+    check_rejected(TEST_CLOCK_HZ, 0);
+    check_rejected(TEST_CLOCK_HZ, 7);
+    check_rejected(TEST_CLOCK_HZ, TEST_CLOCK_HZ / 2 + 1);
+
+    printf("pwm do buzzer: %d erros\n", failures);
+    return failures != 0;
+}
@@ -0,0 +1,334 @@
+#include <string.h>
+
+#include "host.h"
+#include "hal.h"
+#include "ws2812b.h"
+#include "ssd1306.h"
+
+// Tempo de um byte a 400 kHz: 8 bits de dados + ACK.
+#define HOST_I2C_BYTE_US 22.5
+
+// ---- Emulador do SSD1306 ----
+
+// A RAM tem 132 colunas para cobrir também o SH1106, que exibe a partir da coluna
+// SSD1306_COLUMN_OFFSET e só usa endereçamento por página.
+#define HOST_OLED_RAM_COLUMNS 132
+
+typedef struct {
+    uint8_t gddram[HOST_OLED_PAGES][HOST_OLED_RAM_COLUMNS];
+    uint8_t addressing;          // 0 horizontal, 1 vertical, 2 página
+    uint8_t col_start, col_end, page_start, page_end;
+    uint8_t col, page;
+    uint8_t start_line;          // Linha da RAM exibida no topo
+    bool scrolling;              // Rolagem contínua ativa (registrada, não animada)
+    uint8_t command[8];          // Comando em montagem e seus argumentos
+    uint8_t command_len;
+} host_oled_t;
+
+static host_oled_t oled = {.addressing = 2, .col_end = HOST_OLED_WIDTH - 1, .page_end = HOST_OLED_PAGES - 1};
+static host_oled_stats_t oled_stats;
+static uint64_t oled_busy_until = 0;
+
+// Quantidade de argumentos de cada comando que os recebe.
+static uint8_t host_oled_command_args(uint8_t command)
+{
+    switch (command)
+    {
+    case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xAD: case 0xD3: case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+        return 1;
+    case 0x21: case 0x22: case 0xA3:
+        return 2;
+    case 0x29: case 0x2A:
+        return 5;
+    case 0x26: case 0x27:
+        return 6;
+    default:
+        return 0;
+    }
+}
+
+static void host_oled_execute(const uint8_t *cmd)
+{
+    switch (cmd[0])
+    {
+    case 0x20:
+        oled.addressing = cmd[1] & 3;
+        break;
+    case 0x21:
+        oled.col_start = oled.col = cmd[1] & 0x7F;
+        oled.col_end = cmd[2] & 0x7F;
+        break;
+    case 0x22:
+        oled.page_start = oled.page = cmd[1] & 7;
+        oled.page_end = cmd[2] & 7;
+        break;
+    case 0x2E:
+        oled.scrolling = false;
+        break;
+    case 0x2F:
+        oled.scrolling = true;
+        break;
+    default:
+        if (cmd[0] >= 0x40 && cmd[0] <= 0x7F)
+            oled.start_line = cmd[0] & 0x3F;
+        else if (cmd[0] >= 0xB0 && cmd[0] <= 0xB7)
+            oled.page = cmd[0] & 7;
+        else if (cmd[0] <= 0x0F)
+            oled.col = (oled.col & 0xF0) | cmd[0];
+        else if (cmd[0] <= 0x1F)
+            oled.col = (oled.col & 0x0F) | ((cmd[0] & 0x0F) << 4); // SH1106 usa os 4 bits
+        break;
+    }
+}
+
+static void host_oled_command_byte(uint8_t byte)
+{
+    oled.command[oled.command_len++] = byte;
+    if (oled.command_len > host_oled_command_args(oled.command[0]))
+    {
+        host_oled_execute(oled.command);
+        oled.command_len = 0;
+    }
+}
+
+// Grava um byte de dados na GDDRAM e avança o ponteiro conforme o modo de endereçamento.
+static void host_oled_data_byte(uint8_t byte)
+{
+    if (oled.col < HOST_OLED_RAM_COLUMNS)
+        oled.gddram[oled.page][oled.col] = byte;
+
+    switch (oled.addressing)
+    {
+    case 0:
+        if (oled.col++ >= oled.col_end)
+        {
+            oled.col = oled.col_start;
+            oled.page = oled.page >= oled.page_end ? oled.page_start : oled.page + 1;
+        }
+        break;
+    case 1:
+        if (oled.page++ >= oled.page_end)
+        {
+            oled.page = oled.page_start;
+            oled.col = oled.col >= oled.col_end ? oled.col_start : oled.col + 1;
+        }
+        break;
+    default:
+        oled.col++; // Para na última coluna, como no controlador
+        if (oled.col >= HOST_OLED_RAM_COLUMNS)
+            oled.col = HOST_OLED_RAM_COLUMNS - 1;
+        break;
+    }
+}
+
+// Interpreta uma transação I2C: bytes de controle (Co, D/C) seguidos de comandos ou dados.
+static void host_oled_transaction(const uint8_t *data, size_t len)
+{
+    size_t i = 0;
+
+    oled_stats.transactions++;
+    oled_stats.bytes += len + 1; // Mais o byte de endereço
+
+    while (i < len)
+    {
+        uint8_t control = data[i++];
+        bool continuation = control & 0x80;
+        bool is_data = control & 0x40;
+
+        if (continuation)
+        {
+            // Co=1: um único byte e depois outro byte de controle.
+            if (i < len)
+            {
+                if (is_data)
+                    host_oled_data_byte(data[i]);
+                else
+                    host_oled_command_byte(data[i]);
+                i++;
+            }
+            continue;
+        }
+
+        // Co=0: todo o resto da transação é do mesmo tipo.
+        for (; i < len; ++i)
+        {
+            if (is_data)
+                host_oled_data_byte(data[i]);
+            else
+                host_oled_command_byte(data[i]);
+        }
+    }
+}
+
+static uint64_t host_i2c_time_us(size_t bytes)
+{
+    return (uint64_t)(bytes * HOST_I2C_BYTE_US + 0.5);
+}
+
+void hal_i2c_write(i2c_inst_t *i2c, uint8_t address, const uint8_t *data, size_t len)
+{
+    host_oled_transaction(data, len);
+
+    // Escrita bloqueante: o firmware fica parado durante todo o envio.
+    uint64_t bus_us = host_i2c_time_us(len + 1);
+    oled_stats.bus_time_us += bus_us;
+    sleep_us(bus_us);
+}
+
+int hal_i2c_stream_init(i2c_inst_t *i2c)
+{
+    return 0;
+}
+
+// Decodifica o fluxo na hora; o barramento fica ocupado pelo tempo que o envio real levaria.
+void hal_i2c_stream_start(int stream, i2c_inst_t *i2c, uint8_t address, const uint16_t *words, size_t count)
+{
+    uint8_t transaction[2048];
+    size_t len = 0;
+    size_t bytes = 0;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (len < sizeof(transaction))
+            transaction[len++] = words[i] & 0xFF;
+        if (words[i] & HAL_I2C_STOP_BIT)
+        {
+            host_oled_transaction(transaction, len);
+            bytes += len + 1;
+            len = 0;
+        }
+    }
+
+    uint64_t bus_us = host_i2c_time_us(bytes);
+    oled_stats.frames++;
+    oled_stats.bus_time_us += bus_us;
+    oled_busy_until = host_time_us() + bus_us;
+}
+
+hal_i2c_status_t hal_i2c_stream_status(int stream, i2c_inst_t *i2c)
+{
+    return host_time_us() < oled_busy_until ? HAL_I2C_BUSY : HAL_I2C_IDLE;
+}
+
+// Os dois núcleos se revezam no mesmo fio: não há quem acordar.
+void hal_i2c_stream_enable_wake(i2c_inst_t *i2c)
+{
+}
+
+const host_oled_stats_t *host_oled_stats(void)
+{
+    return &oled_stats;
+}
+
+bool host_oled_pixel(int x, int y)
+{
+    // Pixel exibido: a linha inicial desloca a leitura da RAM
+    y = (y + oled.start_line) % (HOST_OLED_PAGES * 8);
+    return (oled.gddram[y >> 3][x + SSD1306_COLUMN_OFFSET] >> (y & 7)) & 1;
+}
+
+// Salva a GDDRAM como PBM binário (P4), 1 = pixel aceso.
+bool host_oled_save_pbm(const char *path)
+{
+    FILE *file = fopen(path, "wb");
+    if (!file)
+        return false;
+
+    fprintf(file, "P4\n%d %d\n", HOST_OLED_WIDTH, HOST_OLED_PAGES * 8);
+    for (int y = 0; y < HOST_OLED_PAGES * 8; ++y)
+    {
+        uint8_t row[HOST_OLED_WIDTH / 8] = {0};
+        for (int x = 0; x < HOST_OLED_WIDTH; ++x)
+        {
+            if (host_oled_pixel(x, y))
+                row[x >> 3] |= 0x80 >> (x & 7);
+        }
+        fwrite(row, 1, sizeof(row), file);
+    }
+
+    return fclose(file) == 0;
+}
+
+// ---- Matriz de LEDs ----
+
+static uint32_t matrix_words[LED_MATRIX_COUNT]; // Cor travada em cada LED: G, R e B nos bits 23 a 0
+static uint32_t matrix_frames = 0;
+
+void hal_ws2812_init(uint pin)
+{
+}
+
+// Reproduz o que cada LED recebe: os bits saem na ordem em que a máquina PIO os desloca
+// e entram no LED como num registrador de deslocamento, o primeiro indo para o bit 23.
+void hal_ws2812_start(const uint32_t *words, size_t count)
+{
+    memset(matrix_words, 0, sizeof(matrix_words));
+#if LED_STRIPS > 1
+    // Fatias de bits, quatro por palavra, do byte menos significativo para o mais
+    const uint8_t *slices = (const uint8_t *)words;
+    size_t leds = MIN(count * 4 / 24, (size_t)LED_STRIP_LEDS);
+
+    for (size_t led = 0; led < leds; ++led)
+    {
+        for (int bit = 0; bit < 24; ++bit)
+        {
+            uint8_t slice = slices[led * 24 + bit];
+            for (int strip = 0; strip < LED_STRIPS; ++strip)
+            {
+                uint32_t *received = &matrix_words[strip * LED_STRIP_LEDS + led];
+                *received = *received << 1 | ((slice >> strip) & 1);
+            }
+        }
+    }
+#else
+    // Uma palavra por LED, deslocada para a esquerda a partir do bit 31
+    for (size_t led = 0; led < MIN(count, (size_t)LED_MATRIX_COUNT); ++led)
+    {
+        for (int bit = 31; bit >= 8; --bit)
+            matrix_words[led] = matrix_words[led] << 1 | ((words[led] >> bit) & 1);
+    }
+#endif
+    matrix_frames++;
+}
+
+uint32_t host_matrix_frames(void)
+{
+    return matrix_frames;
+}
+
+const uint32_t *host_matrix_words(size_t *count)
+{
+    *count = LED_MATRIX_COUNT;
+    return matrix_words;
+}
+
+// Salva o último quadro da matriz como PPM (P6) em coordenadas lógicas, cada LED
+// ampliado para scale x scale pixels.
+bool host_matrix_save_ppm(const char *path, int scale)
+{
+    static uint32_t logical[LED_MATRIX_COUNT];
+    FILE *file = fopen(path, "wb");
+    if (!file)
+        return false;
+
+    // Desfaz a ordem da fita com a mesma tabela usada no envio
+    for (int i = 0; i < LED_MATRIX_COUNT; ++i)
+        logical[led_matrix_transmit[i]] = matrix_words[i];
+
+    fprintf(file, "P6\n%d %d\n255\n", LED_MATRIX_LOGICAL_WIDTH * scale, LED_MATRIX_LOGICAL_HEIGHT * scale);
+    for (int y = LED_MATRIX_LOGICAL_HEIGHT - 1; y >= 0; --y) // Linha 0 é a de baixo
+    {
+        for (int sy = 0; sy < scale; ++sy)
+        {
+            for (int x = 0; x < LED_MATRIX_LOGICAL_WIDTH; ++x)
+            {
+                uint32_t word = logical[y * LED_MATRIX_LOGICAL_WIDTH + x];
+                uint8_t rgb[3] = {(word >> 8) & 0xFF, (word >> 16) & 0xFF, word & 0xFF};
+                for (int sx = 0; sx < scale; ++sx)
+                    fwrite(rgb, 1, sizeof(rgb), file);
+            }
+        }
+    }
+
+    return fclose(file) == 0;
+}
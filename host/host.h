@@ -0,0 +1,44 @@
+#ifndef HOST_H
+#define HOST_H
+
+// Controle da simulação de host: relógio virtual, entradas roteirizadas e captura
+// das saídas do display e da matriz de LEDs.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+
+// Relógio virtual
+uint64_t host_time_us(void);
+void host_run_until(uint64_t time_us);
+
+// Entradas
+void host_gpio_drive(uint gpio, bool level);
+void host_joystick_set(uint16_t x_value, uint16_t y_value);
+
+// Saídas
+bool host_gpio_output(uint gpio);
+uint16_t host_pwm_level(uint gpio);
+uint16_t host_pwm_wrap(uint gpio);
+float host_pwm_clkdiv(uint gpio);
+
+#define HOST_OLED_WIDTH 128
+#define HOST_OLED_PAGES 8
+
+typedef struct {
+    uint32_t frames;       // Fluxos assíncronos recebidos
+    uint64_t bytes;        // Bytes no barramento, incluindo o endereço de cada transação
+    uint32_t transactions; // Transações I2C
+    uint64_t bus_time_us;  // Tempo de barramento a 400 kHz
+} host_oled_stats_t;
+
+const host_oled_stats_t *host_oled_stats(void);
+bool host_oled_pixel(int x, int y);
+bool host_oled_save_pbm(const char *path);
+
+uint32_t host_matrix_frames(void);
+const uint32_t *host_matrix_words(size_t *count);
+bool host_matrix_save_ppm(const char *path, int scale);
+
+#endif // HOST_H
@@ -0,0 +1,13 @@
+#ifndef HOST_HARDWARE_I2C_H
+#define HOST_HARDWARE_I2C_H
+
+#include "pico/stdlib.h"
+
+typedef struct i2c_inst i2c_inst_t;
+extern i2c_inst_t host_i2c0_inst, host_i2c1_inst;
+#define i2c0 (&host_i2c0_inst)
+#define i2c1 (&host_i2c1_inst)
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate);
+
+#endif // HOST_HARDWARE_I2C_H
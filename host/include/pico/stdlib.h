@@ -0,0 +1,95 @@
+#ifndef HOST_PICO_STDLIB_H
+#define HOST_PICO_STDLIB_H
+
+// Subconjunto da API do SDK do Pico usado pelo jogo e pelos drivers, emulado sobre
+// um relógio virtual (host/sdk_host.c). Periféricos com DMA/PIO ficam em lib/hal.h.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef unsigned int uint;
+typedef uint64_t absolute_time_t;
+typedef int32_t alarm_id_t;
+typedef int64_t (*alarm_callback_t)(alarm_id_t id, void *user_data);
+
+struct repeating_timer;
+typedef bool (*repeating_timer_callback_t)(struct repeating_timer *rt);
+
+struct repeating_timer {
+    int64_t delay_us;
+    alarm_id_t alarm_id;
+    repeating_timer_callback_t callback;
+    void *user_data;
+};
+
+#ifndef MIN
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+#endif
+#ifndef MAX
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+#endif
+#define count_of(a) (sizeof(a) / sizeof((a)[0]))
+#define __not_in_flash_func(f) f
+#define __time_critical_func(f) f
+
+// Relógio virtual
+absolute_time_t get_absolute_time(void);
+uint32_t to_ms_since_boot(absolute_time_t t);
+uint64_t to_us_since_boot(absolute_time_t t);
+uint32_t time_us_32(void);
+uint64_t time_us_64(void);
+void sleep_us(uint64_t us);
+void sleep_ms(uint32_t ms);
+
+// Alarmes e timers repetitivos
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past);
+alarm_id_t add_alarm_in_ms(uint32_t ms, alarm_callback_t callback, void *user_data, bool fire_if_past);
+bool cancel_alarm(alarm_id_t alarm_id);
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback, void *user_data, struct repeating_timer *out);
+bool add_repeating_timer_ms(int32_t delay_ms, repeating_timer_callback_t callback, void *user_data, struct repeating_timer *out);
+bool cancel_repeating_timer(struct repeating_timer *timer);
+
+// Pools de alarmes: no host há um único relógio virtual, então todos usam o mesmo.
+typedef struct alarm_pool alarm_pool_t;
+alarm_pool_t *alarm_pool_create_with_unused_hardware_alarm(uint max_timers);
+alarm_id_t alarm_pool_add_alarm_in_us(alarm_pool_t *pool, uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past);
+bool alarm_pool_add_repeating_timer_us(alarm_pool_t *pool, int64_t delay_us, repeating_timer_callback_t callback, void *user_data,
+                                       struct repeating_timer *out);
+
+// GPIO
+#define GPIO_OUT 1
+#define GPIO_IN 0
+#define GPIO_IRQ_EDGE_FALL 0x4u
+#define GPIO_IRQ_EDGE_RISE 0x8u
+enum gpio_function { GPIO_FUNC_I2C, GPIO_FUNC_PWM, GPIO_FUNC_SIO };
+typedef void (*gpio_irq_callback_t)(uint gpio, uint32_t event_mask);
+void gpio_init(uint gpio);
+void gpio_set_dir(uint gpio, bool out);
+void gpio_pull_up(uint gpio);
+void gpio_put(uint gpio, bool value);
+bool gpio_get(uint gpio);
+void gpio_set_function(uint gpio, enum gpio_function fn);
+void gpio_set_irq_enabled(uint gpio, uint32_t events, bool enabled);
+void gpio_set_irq_enabled_with_callback(uint gpio, uint32_t events, bool enabled, gpio_irq_callback_t callback);
+
+// Interrupções e eventos: sem concorrência real no host.
+uint32_t save_and_disable_interrupts(void);
+void restore_interrupts(uint32_t status);
+void host_idle(void);
+static inline void tight_loop_contents(void) { host_idle(); }
+static inline void __wfe(void) { host_idle(); }
+static inline void __wfi(void) { host_idle(); }
+static inline void __sev(void) {}
+static inline void __dmb(void) {}
+static inline uint get_core_num(void) { return 0; } // Os dois núcleos rodam no mesmo fio
+
+bool stdio_init_all(void);
+void panic(const char *fmt, ...); // Imprime a mensagem e aborta a simulação
+
+#define PICO_ERROR_TIMEOUT (-1)
+int getchar_timeout_us(uint32_t timeout_us); // Sem entrada no host: sempre PICO_ERROR_TIMEOUT
+
+#endif // HOST_PICO_STDLIB_H
@@ -0,0 +1,100 @@
+#include <stdio.h>
+
+#include "pico/stdlib.h"
+
+#include "host.h"
+#include "input.h"
+
+// Teste da trepidação dos botões sobre o relógio virtual: uma sequência de bordas
+// roteirizada passa pela interrupção de GPIO e pelo alarme de input.c, e a fila deve
+// conter só as transições estáveis, com o instante da primeira borda de cada uma.
+
+#define TEST_PIN 5
+
+typedef struct {
+    uint32_t time_us; // Instante da borda
+    bool level;       // Nível depois da borda
+} edge_t;
+
+static int failures = 0;
+
+// Aplica as bordas em ordem e deixa o relógio correr até bem depois da última.
+static void drive_edges(const edge_t *edges, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        host_run_until(edges[i].time_us);
+        host_gpio_drive(TEST_PIN, edges[i].level);
+    }
+    host_run_until(edges[count - 1].time_us + 3 * INPUT_DEBOUNCE_US);
+}
+
+// Confere o próximo evento da fila.
+static void expect_event(const char *name, bool pressed, uint32_t timestamp_us)
+{
+    input_event_t event;
+
+    if (!input_poll(&event))
+    {
+        printf("%s: nenhum evento, esperado %s em %u us\n", name, pressed ? "aperto" : "soltura",
+               (unsigned)timestamp_us);
+        failures++;
+        return;
+    }
+
+    if (event.pin != TEST_PIN || event.pressed != pressed || event.timestamp_us != timestamp_us)
+    {
+        printf("%s: pino %u, %s em %u us; esperado pino %u, %s em %u us\n", name, event.pin,
+               event.pressed ? "aperto" : "soltura", (unsigned)event.timestamp_us, TEST_PIN,
+               pressed ? "aperto" : "soltura", (unsigned)timestamp_us);
+        failures++;
+    }
+}
+
+// Confere que a fila está vazia.
+static void expect_no_event(const char *name)
+{
+    input_event_t event;
+
+    while (input_poll(&event))
+    {
+        printf("%s: evento inesperado, %s em %u us\n", name, event.pressed ? "aperto" : "soltura",
+               (unsigned)event.timestamp_us);
+        failures++;
+    }
+}
+
+int main(void)
+{
+    static const uint8_t pins[] = {TEST_PIN};
+
+    gpio_init(TEST_PIN);
+    gpio_pull_up(TEST_PIN); // Solto
+    input_init(pins, 1);
+
+    // Aperto com trepidação: bordas a cada poucas centenas de us até assentar em baixo
+    static const edge_t press_bounce[] = {
+        {10000, false}, {10300, true}, {10450, false}, {11200, true}, {11900, false},
+    };
+    drive_edges(press_bounce, count_of(press_bounce));
+    expect_event("aperto com trepidação", true, 10000);
+    expect_no_event("aperto com trepidação");
+
+    // Pulso mais curto que INPUT_DEBOUNCE_US que volta ao mesmo nível: nenhum evento
+    static const edge_t glitch[] = {
+        {200000, true}, {200000 + INPUT_DEBOUNCE_US / 2, false},
+    };
+    drive_edges(glitch, count_of(glitch));
+    expect_no_event("pulso curto");
+
+    // Soltura com trepidação, agora a partir do nível baixo
+    static const edge_t release_bounce[] = {
+        {400000, true}, {400100, false}, {400900, true}, {401000, false}, {401500, true},
+    };
+    drive_edges(release_bounce, count_of(release_bounce));
+    expect_event("soltura com trepidação", false, 400000);
+    expect_no_event("soltura com trepidação");
+
+    printf("trepidação: %d erros, %u descartados\n", failures, (unsigned)input_dropped());
+    return failures != 0;
+}
@@ -0,0 +1,26 @@
+#include "host.h"
+#include "joystick.h"
+
+// Joystick da simulação: devolve os valores definidos pelo roteiro de entrada.
+static uint16_t joystick_x = JOYSTICK_ADC_CENTER;
+static uint16_t joystick_y = JOYSTICK_ADC_CENTER;
+
+void joystick_init(const joystick_config_t *config)
+{
+}
+
+void joystick_read(uint16_t *x_value, uint16_t *y_value)
+{
+    *x_value = joystick_x;
+    *y_value = joystick_y;
+}
+
+void joystick_set_sample_rate(uint32_t sample_rate_hz)
+{
+}
+
+void host_joystick_set(uint16_t x_value, uint16_t y_value)
+{
+    joystick_x = x_value;
+    joystick_y = y_value;
+}
@@ -0,0 +1,152 @@
+#include <stdio.h>
+
+#include "pico/stdlib.h"
+
+#include "bitboard.h"
+#include "meteors.h"
+
+// Teste do campo de meteoros em mapas de bits. Compilado com dois painéis lado a lado,
+// para que o campo ocupe duas palavras e linhas cruzem a fronteira entre elas.
+
+_Static_assert(BITBOARD_WORDS > 1, "o teste precisa de um campo com mais de uma palavra");
+
+static int failures = 0;
+
+static void check(bool ok, const char *what)
+{
+    if (!ok)
+    {
+        printf("falhou: %s\n", what);
+        failures++;
+    }
+}
+
+// Desce um padrão que acende células em todas as linhas, inclusive nas que cruzam
+// palavras, e compara cada célula com a da linha de cima antes do deslocamento.
+static void test_shift_down(void)
+{
+    bitboard_t board;
+    bool cells[BITBOARD_HEIGHT][BITBOARD_WIDTH];
+
+    bitboard_clear(&board);
+    for (uint y = 0; y < BITBOARD_HEIGHT; ++y)
+    {
+        for (uint x = 0; x < BITBOARD_WIDTH; ++x)
+        {
+            cells[y][x] = (x * 7 + y * 3) % 4 == 0 || x == BITBOARD_WIDTH - 1;
+            if (cells[y][x])
+                bitboard_set(&board, x, y);
+        }
+    }
+
+    for (uint step = 0; step < BITBOARD_HEIGHT; ++step)
+    {
+        bitboard_shift_down(&board);
+
+        for (uint y = 0; y < BITBOARD_HEIGHT; ++y)
+        {
+            for (uint x = 0; x < BITBOARD_WIDTH; ++x)
+            {
+                bool expected = y + step + 1 < BITBOARD_HEIGHT && cells[y + step + 1][x];
+                if (bitboard_test(&board, x, y) != expected)
+                {
+                    printf("shift_down %u: célula (%u, %u) = %d, esperado %d\n", step + 1, x, y,
+                           !expected, expected);
+                    failures++;
+                }
+            }
+        }
+
+        // Os bits acima do campo continuam em zero
+        if (BITBOARD_BITS % 32)
+            check(!(board.words[BITBOARD_WORDS - 1] >> (BITBOARD_BITS % 32)), "bits acima do campo");
+    }
+    check(!bitboard_any(&board), "campo vazio depois de descer todas as linhas");
+}
+
+// Colunas livres do topo: uma coluna ocupada por qualquer classe fica indisponível e
+// volta a ficar livre quando a classe desce.
+static void test_spawn_columns(void)
+{
+    const uint32_t all = (1u << BITBOARD_WIDTH) - 1;
+    meteor_field_t field;
+
+    meteor_field_init(&field);
+    check(meteor_spawn_columns(&field) == all, "todas as colunas livres no início");
+
+    check(meteor_spawn(&field, 0, 0), "meteoro rápido na coluna 0");
+    check(meteor_spawn(&field, BITBOARD_WIDTH - 1, 1), "meteoro lento na última coluna");
+    check(!meteor_spawn(&field, 0, 1), "coluna 0 já ocupada");
+    check(!meteor_spawn(&field, BITBOARD_WIDTH, 0), "coluna fora do campo");
+    check(meteor_spawn_columns(&field) == (all & ~1u & ~(1u << (BITBOARD_WIDTH - 1))), "colunas ocupadas");
+
+    // Períodos {1, 2}: só a classe rápida desce no primeiro passo
+    meteor_step(&field);
+    check(meteor_spawn_columns(&field) == (all & ~(1u << (BITBOARD_WIDTH - 1))), "classe rápida desceu");
+    meteor_step(&field);
+    check(meteor_spawn_columns(&field) == all, "classe lenta desceu");
+    check(meteor_count(&field) == 2, "os dois meteoros continuam no campo");
+}
+
+// Colisão: cada meteoro atingido conta, inclusive dois de classes diferentes na
+// mesma célula, e sai do campo deixando uma explosão. Períodos {1, 2}.
+static void test_collide(void)
+{
+    meteor_field_t field;
+    bitboard_t targets;
+
+    meteor_field_init(&field);
+    for (uint x = 0; x < BITBOARD_WIDTH; x += 2)
+        check(meteor_spawn(&field, x, 0), "meteoro rápido");
+    meteor_step(&field);
+    for (uint x = 0; x < BITBOARD_WIDTH; x += 3)
+        check(meteor_spawn(&field, x, 1), "meteoro lento");
+    meteor_step(&field); // Rápidos desceram duas linhas, lentos uma
+
+    const uint fast_y = BITBOARD_HEIGHT - 3, slow_y = BITBOARD_HEIGHT - 2;
+    const uint fast = (BITBOARD_WIDTH + 1) / 2, slow = (BITBOARD_WIDTH + 2) / 3;
+    bitboard_clear(&targets);
+    check(meteor_collide(&field, &targets) == 0, "nenhum alvo, nenhum acerto");
+
+    // Toda a linha dos rápidos e a coluna 0 inteira: todos os rápidos e um lento
+    for (uint x = 0; x < BITBOARD_WIDTH; ++x)
+        bitboard_set(&targets, x, fast_y);
+    for (uint y = 0; y < BITBOARD_HEIGHT; ++y)
+        bitboard_set(&targets, 0, y);
+
+    uint hits = meteor_collide(&field, &targets);
+    if (hits != fast + 1)
+    {
+        printf("colisão: %u acertos, esperado %u\n", hits, fast + 1);
+        failures++;
+    }
+    check(bitboard_test(&field.explosions, 0, slow_y), "explosão do meteoro lento");
+    check(bitboard_test(&field.explosions, BITBOARD_WIDTH - 2, fast_y), "explosão de um meteoro rápido");
+    check(bitboard_count(&field.explosions) == hits, "uma explosão por meteoro atingido");
+    check(meteor_count(&field) == fast + slow - hits, "meteoros atingidos saem do campo");
+    check(meteor_collide(&field, &targets) == 0, "um meteoro só é atingido uma vez");
+
+    // Um rápido alcança um lento na mesma célula: dois acertos, uma explosão
+    meteor_field_clear(&field);
+    check(meteor_spawn(&field, 4, 1), "meteoro lento na coluna 4");
+    meteor_step(&field);
+    meteor_step(&field); // Lento desce para HEIGHT - 2
+    check(meteor_spawn(&field, 4, 0), "meteoro rápido na coluna 4");
+    meteor_step(&field); // Rápido desce para HEIGHT - 2, lento espera
+    bitboard_clear(&targets);
+    bitboard_set(&targets, 4, BITBOARD_HEIGHT - 2);
+    check(meteor_collide(&field, &targets) == 2, "acertos em duas classes na mesma célula");
+    check(bitboard_count(&field.explosions) == 1, "uma explosão na célula compartilhada");
+    check(meteor_count(&field) == 0, "campo vazio depois dos dois acertos");
+}
+
+int main(void)
+{
+    test_shift_down();
+    test_spawn_columns();
+    test_collide();
+
+    printf("meteoros (%dx%d, %d palavras): %d erros\n", BITBOARD_WIDTH, BITBOARD_HEIGHT, BITBOARD_WORDS,
+           failures);
+    return failures != 0;
+}
@@ -0,0 +1,289 @@
+#include <string.h>
+#include <stdarg.h>
+
+#include "host.h"
+#include "pico/bootrom.h"
+#include "hardware/i2c.h"
+#include "hardware/clocks.h"
+#include "hardware/pwm.h"
+
+#define HOST_MAX_ALARMS 32
+#define HOST_GPIO_COUNT 30
+
+struct i2c_inst {
+    int index;
+};
+
+i2c_inst_t host_i2c0_inst = {0};
+i2c_inst_t host_i2c1_inst = {1};
+
+typedef struct {
+    bool active;
+    uint64_t time_us;
+    alarm_callback_t callback;       // Alarme simples
+    void *user_data;
+    struct repeating_timer *timer;   // Timer repetitivo, se não for nulo
+} host_alarm_t;
+
+static uint64_t now_us = 0;
+static host_alarm_t alarms[HOST_MAX_ALARMS];
+
+static bool gpio_level[HOST_GPIO_COUNT];
+static bool gpio_output[HOST_GPIO_COUNT];
+static uint32_t gpio_irq_mask[HOST_GPIO_COUNT];
+static gpio_irq_callback_t gpio_callback;
+
+static uint16_t pwm_level[HOST_GPIO_COUNT];
+static uint16_t pwm_wrap[HOST_GPIO_COUNT / 2];
+static float pwm_clkdiv[HOST_GPIO_COUNT / 2];
+
+// ---- Relógio virtual e alarmes ----
+
+uint64_t host_time_us(void)
+{
+    return now_us;
+}
+
+static alarm_id_t host_add_alarm(uint64_t time_us, alarm_callback_t callback, void *user_data, struct repeating_timer *timer)
+{
+    for (int i = 0; i < HOST_MAX_ALARMS; ++i)
+    {
+        if (!alarms[i].active)
+        {
+            alarms[i] = (host_alarm_t){true, time_us, callback, user_data, timer};
+            return i + 1;
+        }
+    }
+    return -1;
+}
+
+// Dispara o alarme mais antigo vencido até time_us. Retorna false se não houver.
+static bool host_fire_next(uint64_t time_us)
+{
+    int next = -1;
+    for (int i = 0; i < HOST_MAX_ALARMS; ++i)
+    {
+        if (alarms[i].active && alarms[i].time_us <= time_us && (next < 0 || alarms[i].time_us < alarms[next].time_us))
+            next = i;
+    }
+    if (next < 0)
+        return false;
+
+    // A posição fica reservada durante o callback, que pode cancelar o próprio alarme.
+    host_alarm_t alarm = alarms[next];
+    alarms[next].time_us = UINT64_MAX;
+    if (alarm.time_us > now_us)
+        now_us = alarm.time_us;
+
+    uint64_t base, delay;
+    if (alarm.timer)
+    {
+        struct repeating_timer *timer = alarm.timer;
+        bool again = timer->callback(timer);
+        // Atraso negativo conta do início anterior; positivo, do fim do callback.
+        base = timer->delay_us < 0 ? alarm.time_us : now_us;
+        delay = again ? (timer->delay_us < 0 ? -timer->delay_us : timer->delay_us) : 0;
+    }
+    else
+    {
+        int64_t again = alarm.callback(next + 1, alarm.user_data);
+        base = again < 0 ? alarm.time_us : now_us;
+        delay = again < 0 ? -again : again;
+    }
+
+    if (!alarms[next].active)
+        return true; // Cancelado pelo callback
+    if (delay == 0)
+        alarms[next].active = false;
+    else
+        alarms[next].time_us = base + delay;
+    return true;
+}
+
+// Avança o relógio até time_us, disparando os alarmes na ordem.
+void host_run_until(uint64_t time_us)
+{
+    while (host_fire_next(time_us))
+        ;
+    if (time_us > now_us)
+        now_us = time_us;
+}
+
+// Espera ativa do firmware: avança o relógio em 1 us.
+void host_idle(void)
+{
+    host_run_until(now_us + 1);
+}
+
+absolute_time_t get_absolute_time(void) { return now_us; }
+uint32_t to_ms_since_boot(absolute_time_t t) { return (uint32_t)(t / 1000); }
+uint64_t to_us_since_boot(absolute_time_t t) { return t; }
+uint32_t time_us_32(void) { return (uint32_t)now_us; }
+uint64_t time_us_64(void) { return now_us; }
+void sleep_us(uint64_t us) { host_run_until(now_us + us); }
+void sleep_ms(uint32_t ms) { sleep_us((uint64_t)ms * 1000); }
+
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past)
+{
+    return host_add_alarm(now_us + us, callback, user_data, NULL);
+}
+
+alarm_id_t add_alarm_in_ms(uint32_t ms, alarm_callback_t callback, void *user_data, bool fire_if_past)
+{
+    return add_alarm_in_us((uint64_t)ms * 1000, callback, user_data, fire_if_past);
+}
+
+bool cancel_alarm(alarm_id_t alarm_id)
+{
+    if (alarm_id <= 0 || alarm_id > HOST_MAX_ALARMS || !alarms[alarm_id - 1].active)
+        return false;
+    alarms[alarm_id - 1].active = false;
+    return true;
+}
+
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback, void *user_data, struct repeating_timer *out)
+{
+    out->delay_us = delay_us;
+    out->callback = callback;
+    out->user_data = user_data;
+    out->alarm_id = host_add_alarm(now_us + (delay_us < 0 ? -delay_us : delay_us), NULL, NULL, out);
+    return out->alarm_id > 0;
+}
+
+bool add_repeating_timer_ms(int32_t delay_ms, repeating_timer_callback_t callback, void *user_data, struct repeating_timer *out)
+{
+    return add_repeating_timer_us((int64_t)delay_ms * 1000, callback, user_data, out);
+}
+
+bool cancel_repeating_timer(struct repeating_timer *timer)
+{
+    bool cancelled = cancel_alarm(timer->alarm_id);
+    timer->alarm_id = 0;
+    return cancelled;
+}
+
+struct alarm_pool
+{
+    uint max_timers;
+};
+
+alarm_pool_t *alarm_pool_create_with_unused_hardware_alarm(uint max_timers)
+{
+    static alarm_pool_t pool;
+    pool.max_timers = max_timers;
+    return &pool;
+}
+
+alarm_id_t alarm_pool_add_alarm_in_us(alarm_pool_t *pool, uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past)
+{
+    return add_alarm_in_us(us, callback, user_data, fire_if_past);
+}
+
+bool alarm_pool_add_repeating_timer_us(alarm_pool_t *pool, int64_t delay_us, repeating_timer_callback_t callback, void *user_data,
+                                       struct repeating_timer *out)
+{
+    return add_repeating_timer_us(delay_us, callback, user_data, out);
+}
+
+uint32_t save_and_disable_interrupts(void) { return 0; }
+void restore_interrupts(uint32_t status) { (void)status; }
+bool stdio_init_all(void) { return true; }
+
+int getchar_timeout_us(uint32_t timeout_us) { return PICO_ERROR_TIMEOUT; }
+
+void panic(const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    vfprintf(stderr, fmt, args);
+    va_end(args);
+    fputc('\n', stderr);
+    abort();
+}
+
+void reset_usb_boot(uint32_t gpio_activity_pin_mask, uint32_t disable_interface_mask)
+{
+    printf("[host] reset_usb_boot ignorado\n");
+}
+
+uint32_t clock_get_hz(enum clock_index clk_index)
+{
+    return clk_index == clk_adc ? 48000000u : 125000000u;
+}
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate) { return baudrate; }
+
+// ---- GPIO ----
+
+void gpio_init(uint gpio)
+{
+    gpio_output[gpio] = false;
+    gpio_level[gpio] = false;
+}
+
+void gpio_set_dir(uint gpio, bool out) { gpio_output[gpio] = out; }
+void gpio_pull_up(uint gpio) { gpio_level[gpio] = true; }
+void gpio_put(uint gpio, bool value) { gpio_level[gpio] = value; }
+bool gpio_get(uint gpio) { return gpio_level[gpio]; }
+void gpio_set_function(uint gpio, enum gpio_function fn) {}
+
+void gpio_set_irq_enabled(uint gpio, uint32_t events, bool enabled)
+{
+    if (enabled)
+        gpio_irq_mask[gpio] |= events;
+    else
+        gpio_irq_mask[gpio] &= ~events;
+}
+
+void gpio_set_irq_enabled_with_callback(uint gpio, uint32_t events, bool enabled, gpio_irq_callback_t callback)
+{
+    gpio_callback = callback;
+    gpio_set_irq_enabled(gpio, events, enabled);
+}
+
+// Muda o nível de uma entrada e gera a interrupção de borda, se habilitada.
+void host_gpio_drive(uint gpio, bool level)
+{
+    bool previous = gpio_level[gpio];
+    gpio_level[gpio] = level;
+
+    uint32_t event = 0;
+    if (previous && !level)
+        event = GPIO_IRQ_EDGE_FALL;
+    else if (!previous && level)
+        event = GPIO_IRQ_EDGE_RISE;
+
+    if (event & gpio_irq_mask[gpio] && gpio_callback)
+        gpio_callback(gpio, event);
+}
+
+bool host_gpio_output(uint gpio)
+{
+    return gpio_level[gpio];
+}
+
+// ---- PWM ----
+
+uint pwm_gpio_to_slice_num(uint gpio) { return (gpio >> 1) & 7; }
+
+pwm_config pwm_get_default_config(void)
+{
+    return (pwm_config){1.0f, 0xFFFF};
+}
+
+void pwm_config_set_clkdiv(pwm_config *c, float div) { c->clkdiv = div; }
+
+void pwm_init(uint slice_num, pwm_config *c, bool start)
+{
+    pwm_clkdiv[slice_num] = c->clkdiv;
+    pwm_wrap[slice_num] = c->top;
+}
+
+void pwm_set_wrap(uint slice_num, uint16_t wrap) { pwm_wrap[slice_num] = wrap; }
+void pwm_set_clkdiv(uint slice_num, float divider) { pwm_clkdiv[slice_num] = divider; }
+void pwm_set_clkdiv_int_frac(uint slice_num, uint8_t integer, uint8_t fract) { pwm_clkdiv[slice_num] = integer + fract / 16.0f; }
+void pwm_set_gpio_level(uint gpio, uint16_t level) { pwm_level[gpio] = level; }
+
+uint16_t host_pwm_level(uint gpio) { return pwm_level[gpio]; }
+uint16_t host_pwm_wrap(uint gpio) { return pwm_wrap[pwm_gpio_to_slice_num(gpio)]; }
+float host_pwm_clkdiv(uint gpio) { return pwm_clkdiv[pwm_gpio_to_slice_num(gpio)]; }
@@ -0,0 +1,229 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "host.h"
+#include "game.h"
+#include "lib/scheduler.h"
+#include "lib/joystick.h"
+#include "lib/profiler.h"
+#include "lib/log_ring.h"
+#include "lib/audio.h"
+
+// Simulação do jogo no host. O firmware roda sobre um relógio virtual e as entradas
+// vêm de um roteiro com uma ação por linha:
+//   <ms> press A|B|SW     pressiona o botão (solta 50 ms depois)
+//   <ms> joystick <x> <y> posiciona o joystick (0 a 4095)
+//   <ms> end              encerra a simulação
+// Linhas vazias ou começando com '#' são ignoradas.
+
+#define SIM_PRESS_MS 50
+#define SIM_STEP_US 100
+#define SIM_MAX_EVENTS 256
+#define SIM_MATRIX_SCALE 16
+
+typedef enum {
+    SIM_PRESS,
+    SIM_RELEASE,
+    SIM_JOYSTICK,
+    SIM_END,
+} sim_action_t;
+
+typedef struct {
+    uint64_t time_us;
+    sim_action_t action;
+    uint gpio;
+    uint16_t x, y;
+} sim_event_t;
+
+static sim_event_t events[SIM_MAX_EVENTS];
+static size_t event_count = 0;
+
+static void sim_add_event(sim_event_t event)
+{
+    if (event_count == SIM_MAX_EVENTS)
+    {
+        fprintf(stderr, "Roteiro com eventos demais, o resto foi ignorado\n");
+        return;
+    }
+
+    // Inserção ordenada por tempo; eventos no mesmo instante mantêm a ordem do roteiro
+    size_t i = event_count++;
+    while (i > 0 && events[i - 1].time_us > event.time_us)
+    {
+        events[i] = events[i - 1];
+        i--;
+    }
+    events[i] = event;
+}
+
+static bool sim_load_script(const char *path)
+{
+    FILE *file = fopen(path, "r");
+    if (!file)
+    {
+        perror(path);
+        return false;
+    }
+
+    char line[128];
+    int line_number = 0;
+    while (fgets(line, sizeof(line), file))
+    {
+        unsigned long ms;
+        char action[16], argument[16];
+        unsigned x, y;
+
+        line_number++;
+        if (line[0] == '#' || line[0] == '\n' || line[0] == '\0')
+            continue;
+
+        int fields = sscanf(line, "%lu %15s %15s %u", &ms, action, argument, &y);
+        if (fields >= 3 && strcmp(action, "press") == 0)
+        {
+            uint gpio = strcmp(argument, "A") == 0 ? BTN_A_PIN : strcmp(argument, "B") == 0 ? BTN_B_PIN : SW_PIN;
+            sim_add_event((sim_event_t){.time_us = ms * 1000, .action = SIM_PRESS, .gpio = gpio});
+            sim_add_event((sim_event_t){.time_us = (ms + SIM_PRESS_MS) * 1000, .action = SIM_RELEASE, .gpio = gpio});
+        }
+        else if (fields == 4 && strcmp(action, "joystick") == 0 && sscanf(argument, "%u", &x) == 1)
+        {
+            sim_add_event((sim_event_t){.time_us = ms * 1000, .action = SIM_JOYSTICK, .x = x, .y = y});
+        }
+        else if (fields >= 2 && strcmp(action, "end") == 0)
+        {
+            sim_add_event((sim_event_t){.time_us = ms * 1000, .action = SIM_END});
+        }
+        else
+        {
+            fprintf(stderr, "%s:%d: linha inválida\n", path, line_number);
+        }
+    }
+
+    fclose(file);
+    return true;
+}
+
+// Inicializa a placa simulada na mesma ordem de main.c
+static void sim_init(void)
+{
+    const uint pins[] = {GREEN_LED_PIN, BLUE_LED_PIN, RED_LED_PIN};
+    const uint8_t buttons[] = {BTN_A_PIN, BTN_B_PIN, SW_PIN};
+    const joystick_config_t joystick_config = {0};
+
+    game_init();
+    for (size_t i = 0; i < sizeof(pins) / sizeof(pins[0]); ++i)
+    {
+        gpio_init(pins[i]);
+        gpio_set_dir(pins[i], GPIO_OUT);
+    }
+    for (size_t i = 0; i < sizeof(buttons) / sizeof(buttons[0]); ++i)
+    {
+        gpio_init(buttons[i]);
+        gpio_set_dir(buttons[i], GPIO_IN);
+        gpio_pull_up(buttons[i]);
+    }
+
+    ssd1306_init(&ssd, WIDTH, HEIGHT, false, I2C_ADDRESS, I2C_PORT);
+    ssd1306_config(&ssd);
+    ssd1306_fill(&ssd, false);
+    ssd1306_send_data(&ssd);
+
+    audio_init(BUZZER_A_PIN);
+    ws2812b_init(LED_MATRIX_PIN);
+    joystick_init(&joystick_config);
+
+    input_init(buttons, sizeof(buttons));
+
+    ws2812b_clear();
+    ws2812b_set_led_xy(spaceship_x, 0, 0, 0, 186);
+    ws2812b_write();
+
+    game_start_tasks();
+}
+
+// Salva o display e a matriz sempre que um deles recebe um quadro novo
+static void sim_dump_frames(const char *output_dir)
+{
+    static uint32_t oled_frames = 0;
+    static uint32_t matrix_frames = 0;
+    char path[512];
+
+    if (host_oled_stats()->frames != oled_frames)
+    {
+        oled_frames = host_oled_stats()->frames;
+        snprintf(path, sizeof(path), "%s/oled_%05u_%08llu.pbm", output_dir, oled_frames,
+                 (unsigned long long)host_time_us());
+        host_oled_save_pbm(path);
+    }
+
+    // Com dithering a matriz é reenviada a cada tique; só os quadros novos são salvos
+    if (ws2812b_last_frame() != matrix_frames)
+    {
+        matrix_frames = ws2812b_last_frame();
+        snprintf(path, sizeof(path), "%s/matrix_%05u_%08llu.ppm", output_dir, matrix_frames,
+                 (unsigned long long)host_time_us());
+        host_matrix_save_ppm(path, SIM_MATRIX_SCALE);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "uso: %s <roteiro> [diretório de saída] [duração em ms]\n", argv[0]);
+        return 1;
+    }
+
+    const char *output_dir = argc > 2 && strcmp(argv[2], "-") != 0 ? argv[2] : NULL;
+    uint64_t duration_us = argc > 3 ? strtoull(argv[3], NULL, 10) * 1000 : 10 * 1000 * 1000;
+
+    if (!sim_load_script(argv[1]))
+        return 1;
+
+    srand(1); // Meteoros reprodutíveis entre execuções
+    clock_t wall_start = clock();
+
+    sim_init();
+
+    size_t next_event = 0;
+    while (host_time_us() < duration_us)
+    {
+        for (; next_event < event_count && events[next_event].time_us <= host_time_us(); ++next_event)
+        {
+            const sim_event_t *event = &events[next_event];
+            if (event->action == SIM_PRESS)
+                host_gpio_drive(event->gpio, false);
+            else if (event->action == SIM_RELEASE)
+                host_gpio_drive(event->gpio, true);
+            else if (event->action == SIM_JOYSTICK)
+                host_joystick_set(event->x, event->y);
+            else
+                duration_us = host_time_us();
+        }
+
+        // Os dois núcleos se revezam no mesmo fio de execução
+        scheduler_run_pending();
+        render_poll();
+
+        if (output_dir)
+            sim_dump_frames(output_dir);
+
+        host_run_until(host_time_us() + SIM_STEP_US);
+    }
+
+    log_drain();
+
+    double wall_s = (double)(clock() - wall_start) / CLOCKS_PER_SEC;
+    const host_oled_stats_t *oled = host_oled_stats();
+
+    printf("\n--- Simulação: %.3f s virtuais em %.3f s reais ---\n", host_time_us() / 1e6, wall_s);
+    printf("OLED: %u quadros, %u transações, %llu bytes, %.1f ms de barramento\n", oled->frames,
+           oled->transactions, (unsigned long long)oled->bytes, oled->bus_time_us / 1e3);
+    printf("Matriz: %u quadros, %u envios\n", ws2812b_last_frame(), host_matrix_frames());
+    printf("Fila: profundidade máxima %u, %u descartados cheia, %u descartados antigos\n",
+           frame_queue.max_depth, frame_queue.dropped_full, frame_queue.dropped_stale);
+    profile_dump(); // Tempos virtuais: só as etapas que esperam o barramento aparecem
+
+    return 0;
+}
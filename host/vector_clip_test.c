@@ -0,0 +1,120 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+
+#include "ssd1306.h"
+#include "vector.h"
+
+// Teste do recorte das primitivas vetoriais: linhas, círculos e triângulos com
+// coordenadas muito fora da tela, até ±32767, desenhados num buffer cercado de bytes
+// de guarda. Nada fora de ram_buffer[1..SSD1306_BUFSIZE) pode mudar, nem o byte de
+// controle em ram_buffer[0].
+
+#define GUARD_BYTES 4096
+#define GUARD_VALUE 0xA5
+
+static uint8_t memory[GUARD_BYTES + SSD1306_BUFSIZE + GUARD_BYTES];
+static int failures = 0;
+
+// Confere as guardas e o byte de controle depois de cada desenho.
+static void check_guards(const char *what)
+{
+    int damaged = 0;
+
+    for (size_t i = 0; i < GUARD_BYTES; ++i)
+    {
+        damaged += memory[i] != GUARD_VALUE;
+        damaged += memory[GUARD_BYTES + SSD1306_BUFSIZE + i] != GUARD_VALUE;
+    }
+    damaged += memory[GUARD_BYTES] != 0x40;
+
+    if (damaged)
+    {
+        printf("%s: %d bytes fora do framebuffer alterados\n", what, damaged);
+        failures++;
+    }
+}
+
+// Confere que um desenho inteiramente fora da tela não mudou o framebuffer.
+static void check_untouched(ssd1306_t *ssd, bool background, const char *what)
+{
+    for (size_t i = 1; i < SSD1306_BUFSIZE; ++i)
+    {
+        if (ssd->ram_buffer[i] != (background ? 0xFF : 0x00))
+        {
+            printf("%s: desenho fora da tela alterou o byte %u\n", what, (unsigned)i);
+            failures++;
+            return;
+        }
+    }
+}
+
+// Coordenadas nas bordas, logo fora delas e nos extremos de int16_t
+static const int coords[] = {-32767, -20000, -129, -1, 0, 5, 63, 64, 127, 128, 200, 20000, 32767};
+static const int radii[] = {0, 1, 7, 64, 100, 1000, 20000, 32767};
+
+int main(void)
+{
+    ssd1306_t ssd;
+    char what[96];
+
+    ssd1306_init(&ssd, SSD1306_WIDTH, SSD1306_HEIGHT, false, 0x3C, i2c1);
+
+    memset(memory, GUARD_VALUE, sizeof(memory));
+    ssd.ram_buffer = memory + GUARD_BYTES;
+    ssd.ram_buffer[0] = 0x40;
+
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        bool value = pass == 0; // Acende sobre a tela apagada, depois apaga sobre a acesa
+        const size_t n = count_of(coords);
+
+        for (size_t a = 0; a < n; ++a)
+        {
+            for (size_t b = 0; b < n; ++b)
+            {
+                int x0 = coords[a], y0 = coords[b];
+                int x1 = coords[n - 1 - b], y1 = coords[(a + 3) % n];
+                int x2 = coords[(b + 5) % n], y2 = coords[n - 1 - a];
+
+                memset(ssd.ram_buffer + 1, value ? 0x00 : 0xFF, SSD1306_BUFSIZE - 1);
+
+                vector_line(&ssd, x0, y0, x1, y1, value);
+                snprintf(what, sizeof(what), "linha (%d, %d)-(%d, %d)", x0, y0, x1, y1);
+                check_guards(what);
+
+                vector_fill_triangle(&ssd, x0, y0, x1, y1, x2, y2, value);
+                snprintf(what, sizeof(what), "triângulo (%d, %d) (%d, %d) (%d, %d)", x0, y0, x1, y1, x2, y2);
+                check_guards(what);
+
+                const vector_point_t points[] = {{x0, y0}, {x1, y1}, {x2, y2}};
+                vector_polyline(&ssd, points, count_of(points), true, value);
+                snprintf(what, sizeof(what), "polilinha (%d, %d) (%d, %d) (%d, %d)", x0, y0, x1, y1, x2, y2);
+                check_guards(what);
+
+                for (size_t r = 0; r < count_of(radii); ++r)
+                {
+                    vector_circle(&ssd, x0, y0, radii[r], value);
+                    vector_fill_circle(&ssd, x0, y0, radii[r], value);
+                    snprintf(what, sizeof(what), "círculo (%d, %d) raio %d", x0, y0, radii[r]);
+                    check_guards(what);
+                }
+            }
+        }
+
+        // Formas inteiramente fora da tela não desenham nada
+        memset(ssd.ram_buffer + 1, value ? 0x00 : 0xFF, SSD1306_BUFSIZE - 1);
+        vector_line(&ssd, -32767, -32767, -1, 32767, value);
+        vector_line(&ssd, SSD1306_WIDTH, -32767, 32767, 32767, value);
+        vector_line(&ssd, -32767, SSD1306_HEIGHT, 32767, 32767, value);
+        vector_fill_triangle(&ssd, -32767, -32767, 32767, -32767, 0, -1, value);
+        vector_fill_circle(&ssd, -32767, 32, 32767 - 1, value);
+        vector_circle(&ssd, 64, -32767, 32767 - SSD1306_HEIGHT, value);
+        check_guards("formas fora da tela");
+        check_untouched(&ssd, !value, "formas fora da tela");
+    }
+
+    printf("recorte vetorial: %d erros\n", failures);
+    return failures != 0;
+}
@@ -0,0 +1,49 @@
+#include <stdio.h>
+
+#include "pico/stdlib.h"
+
+#include "host.h"
+#include "ws2812b.h"
+
+// Teste da saída paralela: cada fita recebe uma cor GRB conhecida, diferente nas três
+// cores e assimétrica em cada byte, e o decodificador do host lê as fatias na ordem do
+// fio (bit 7 primeiro). Compilado com LED_STRIPS = 8, gama 1.0 e brilho máximo, para o
+// valor enviado ser o próprio valor do framebuffer.
+
+static const uint32_t lane_colors[8] = {
+    0x80C001, 0x01A57E, 0x3C0F92, 0xFF0010, 0x0800F1, 0x5A6B7C, 0xE00307, 0x13579B,
+};
+
+int main(void)
+{
+    int failures = 0;
+
+    ws2812b_init(0);
+
+    // A tabela de envio leva cada posição da cadeia ao pixel lógico correspondente
+    for (uint i = 0; i < LED_MATRIX_COUNT; ++i)
+    {
+        uint32_t grb = lane_colors[i / LED_STRIP_LEDS];
+        ws2812b_LED_t *led = &led_matrix[led_matrix_transmit[i]];
+        led->G = grb >> 16;
+        led->R = grb >> 8;
+        led->B = grb;
+    }
+    ws2812b_present();
+
+    size_t count;
+    const uint32_t *received = host_matrix_words(&count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        uint32_t expected = lane_colors[i / LED_STRIP_LEDS];
+        if (received[i] != expected)
+        {
+            if (failures++ < 8)
+                printf("fita %u, LED %u: recebeu %06X, esperado %06X\n", (unsigned)(i / LED_STRIP_LEDS),
+                       (unsigned)(i % LED_STRIP_LEDS), (unsigned)received[i], (unsigned)expected);
+        }
+    }
+
+    printf("%d fitas x %d LEDs: %d erros\n", LED_STRIPS, LED_STRIP_LEDS, failures);
+    return failures != 0;
+}
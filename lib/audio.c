@@ -0,0 +1,164 @@
+#include "audio.h"
+#include "hardware/clocks.h"
+#include "hardware/pwm.h"
+#include "hardware/sync.h"
+
+typedef struct {
+    const audio_note_t *notes;
+    size_t count;
+} audio_sequence_t;
+
+static uint audio_pin;
+static uint audio_slice;
+static audio_sequence_t audio_queue[AUDIO_QUEUE_SIZE];
+static uint32_t queue_head = 0, queue_tail = 0;
+static const audio_note_t *current_note; // Nota tocando agora
+static size_t notes_left = 0;            // Notas da sequência atual, contando a que toca
+static bool audio_active = false;        // Há um alarme agendado para a próxima nota
+static alarm_id_t audio_alarm;
+
+// Inicializa o PWM do buzzer, em silêncio.
+void audio_init(uint pin)
+{
+    audio_pin = pin;
+    audio_slice = pwm_gpio_to_slice_num(pin);
+
+    gpio_set_function(pin, GPIO_FUNC_PWM);
+    pwm_config config = pwm_get_default_config();
+    pwm_init(audio_slice, &config, true);
+    pwm_set_gpio_level(pin, 0);
+}
+
+// Período em 1/16 de ciclo do clock e, dele, o menor divisor que deixa a contagem caber
+// nos 16 bits do wrap: de 7,5 Hz a metade do clock com 125 MHz.
+bool audio_pwm_compute(uint32_t clock_hz, uint32_t frequency_hz, audio_pwm_t *pwm)
+{
+    if (frequency_hz == 0 || frequency_hz > clock_hz / 2)
+        return false;
+
+    uint64_t period_16 = ((uint64_t)clock_hz << 4) / frequency_hz;
+    uint32_t divider_16 = (period_16 + 0xFFFF) >> 16;
+
+    if (divider_16 < 16)
+        divider_16 = 16; // Divisor mínimo de 1.0
+    if (divider_16 > 0xFFF)
+        return false; // Abaixo do alcance do divisor máximo de 255 + 15/16
+
+    uint32_t counts = (period_16 + divider_16 / 2) / divider_16;
+    pwm->divider_16 = divider_16;
+    pwm->wrap = MIN(counts, 0x10000u) - 1;
+    return true;
+}
+
+// Toca a nota no PWM, com 50% de ciclo ativo. Pausas e frequências fora do alcance
+// deixam a saída em zero.
+static void audio_start_note(const audio_note_t *note)
+{
+    audio_pwm_t pwm;
+
+    if (!audio_pwm_compute(clock_get_hz(clk_sys), note->frequency_hz, &pwm))
+    {
+        pwm_set_gpio_level(audio_pin, 0);
+        return;
+    }
+
+    pwm_set_clkdiv_int_frac(audio_slice, pwm.divider_16 >> 4, pwm.divider_16 & 0xF);
+    pwm_set_wrap(audio_slice, pwm.wrap);
+    pwm_set_gpio_level(audio_pin, (pwm.wrap + 1) / 2);
+}
+
+// Passa para a próxima nota da sequência atual ou da fila. Retorna a duração dela em
+// µs, ou 0 quando não há mais nada a tocar. Roda no alarme ou com as interrupções
+// mascaradas.
+static int64_t audio_advance(void)
+{
+    if (notes_left > 1)
+    {
+        ++current_note;
+        --notes_left;
+    }
+    else if (queue_tail != queue_head)
+    {
+        const audio_sequence_t *sequence = &audio_queue[queue_tail % AUDIO_QUEUE_SIZE];
+        current_note = sequence->notes;
+        notes_left = sequence->count;
+        ++queue_tail;
+    }
+    else
+    {
+        notes_left = 0;
+        audio_active = false;
+        pwm_set_gpio_level(audio_pin, 0);
+        return 0;
+    }
+
+    audio_start_note(current_note);
+    return (int64_t)MAX(current_note->duration_ms, 1) * 1000;
+}
+
+// Fim de uma nota. O retorno negativo reagenda o mesmo alarme a partir do instante
+// previsto, e não do atraso com que este disparou: a sequência não acumula deriva.
+static int64_t audio_alarm_callback(alarm_id_t id, void *user_data)
+{
+    return -audio_advance();
+}
+
+// Enfileira uma sequência de notas. O vetor precisa continuar válido até ela tocar.
+// Retorna false se a fila estiver cheia. Chamado pelo núcleo 0, que também atende o
+// alarme: mascarar as interrupções basta para não disputar com ele.
+bool audio_play(const audio_note_t *notes, size_t count)
+{
+    if (count == 0)
+        return true;
+
+    uint32_t status = save_and_disable_interrupts();
+    if (queue_head - queue_tail >= AUDIO_QUEUE_SIZE)
+    {
+        restore_interrupts(status);
+        return false;
+    }
+
+    audio_queue[queue_head % AUDIO_QUEUE_SIZE] = (audio_sequence_t){notes, count};
+    ++queue_head;
+    bool queued = true;
+
+    // Parado: toca a primeira nota já e agenda o alarme que cuida do resto
+    if (!audio_active)
+    {
+        int64_t duration_us = audio_advance();
+        audio_active = true;
+        audio_alarm = add_alarm_in_us(duration_us, audio_alarm_callback, NULL, true);
+        if (audio_alarm < 0)
+        {
+            // Sem alarmes livres: descarta o som em vez de deixar a nota presa
+            notes_left = 0;
+            queue_tail = queue_head;
+            audio_active = false;
+            pwm_set_gpio_level(audio_pin, 0);
+            queued = false;
+        }
+    }
+
+    restore_interrupts(status);
+    return queued;
+}
+
+// Interrompe o som atual e descarta a fila.
+void audio_stop(void)
+{
+    uint32_t status = save_and_disable_interrupts();
+
+    if (audio_active)
+        cancel_alarm(audio_alarm);
+    audio_active = false;
+    notes_left = 0;
+    queue_tail = queue_head;
+    pwm_set_gpio_level(audio_pin, 0);
+
+    restore_interrupts(status);
+}
+
+bool audio_is_playing(void)
+{
+    return audio_active;
+}
@@ -0,0 +1,35 @@
+#ifndef AUDIO_H
+#define AUDIO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "pico/stdlib.h"
+
+// Sequenciador de notas para o buzzer: cada nota é uma onda quadrada gerada pelo PWM
+// e um alarme avança para a próxima quando a duração vence. Quem toca um som só
+// enfileira a sequência e segue; nada espera a nota terminar.
+
+#ifndef AUDIO_QUEUE_SIZE
+#define AUDIO_QUEUE_SIZE 4 // Sequências na fila, além da que está tocando
+#endif
+
+typedef struct {
+    uint16_t frequency_hz; // 0 é pausa
+    uint16_t duration_ms;
+} audio_note_t;
+
+// Divisor em 8.4 (como o registrador DIV do PWM) e wrap que geram frequency_hz a partir
+// de clock_hz com a maior resolução possível.
+typedef struct {
+    uint16_t divider_16;
+    uint16_t wrap;
+} audio_pwm_t;
+
+void audio_init(uint pin);
+bool audio_pwm_compute(uint32_t clock_hz, uint32_t frequency_hz, audio_pwm_t *pwm);
+bool audio_play(const audio_note_t *notes, size_t count);
+void audio_stop(void);
+bool audio_is_playing(void);
+
+#endif // AUDIO_H
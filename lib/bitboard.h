@@ -0,0 +1,116 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+#include "led_matrix_geometry.h"
+
+// Mapa de bits do campo lógico da matriz: o bit y * BITBOARD_WIDTH + x representa a
+// célula (x, y). Em matrizes maiores que 32 células o mapa ocupa várias palavras;
+// bits acima de BITBOARD_BITS ficam sempre em zero.
+#define BITBOARD_WIDTH LED_MATRIX_LOGICAL_WIDTH
+#define BITBOARD_HEIGHT LED_MATRIX_LOGICAL_HEIGHT
+#define BITBOARD_BITS (BITBOARD_WIDTH * BITBOARD_HEIGHT)
+#define BITBOARD_WORDS ((BITBOARD_BITS + 31) / 32)
+
+_Static_assert(BITBOARD_WIDTH <= 32, "uma linha do campo precisa caber em uma palavra");
+
+typedef struct {
+    uint32_t words[BITBOARD_WORDS];
+} bitboard_t;
+
+static inline void bitboard_clear(bitboard_t *board)
+{
+    for (int i = 0; i < BITBOARD_WORDS; ++i)
+        board->words[i] = 0;
+}
+
+static inline void bitboard_set(bitboard_t *board, uint x, uint y)
+{
+    uint bit = y * BITBOARD_WIDTH + x;
+    board->words[bit / 32] |= 1u << (bit % 32);
+}
+
+static inline bool bitboard_test(const bitboard_t *board, uint x, uint y)
+{
+    uint bit = y * BITBOARD_WIDTH + x;
+    return (board->words[bit / 32] >> (bit % 32)) & 1;
+}
+
+static inline void bitboard_or(bitboard_t *board, const bitboard_t *other)
+{
+    for (int i = 0; i < BITBOARD_WORDS; ++i)
+        board->words[i] |= other->words[i];
+}
+
+static inline void bitboard_and(bitboard_t *board, const bitboard_t *other)
+{
+    for (int i = 0; i < BITBOARD_WORDS; ++i)
+        board->words[i] &= other->words[i];
+}
+
+static inline void bitboard_andnot(bitboard_t *board, const bitboard_t *other)
+{
+    for (int i = 0; i < BITBOARD_WORDS; ++i)
+        board->words[i] &= ~other->words[i];
+}
+
+static inline bool bitboard_any(const bitboard_t *board)
+{
+    uint32_t any = 0;
+    for (int i = 0; i < BITBOARD_WORDS; ++i)
+        any |= board->words[i];
+    return any != 0;
+}
+
+static inline uint bitboard_count(const bitboard_t *board)
+{
+    uint count = 0;
+    for (int i = 0; i < BITBOARD_WORDS; ++i)
+        count += __builtin_popcount(board->words[i]);
+    return count;
+}
+
+// Desce todo o campo uma linha (y - 1): um deslocamento de BITBOARD_WIDTH bits para a
+// direita, levando os bits entre palavras. A linha 0 sai do campo.
+static inline void bitboard_shift_down(bitboard_t *board)
+{
+    const uint words = BITBOARD_WIDTH / 32; // Sempre 0 enquanto a linha couber em uma palavra
+    const uint bits = BITBOARD_WIDTH % 32;
+
+    for (uint i = 0; i < BITBOARD_WORDS; ++i)
+    {
+        uint32_t low = i + words < BITBOARD_WORDS ? board->words[i + words] : 0;
+        uint32_t high = i + words + 1 < BITBOARD_WORDS ? board->words[i + words + 1] : 0;
+        board->words[i] = bits ? (low >> bits) | (high << (32 - bits)) : low;
+    }
+}
+
+// Bits da linha y, com o bit x na posição x.
+static inline uint32_t bitboard_row(const bitboard_t *board, uint y)
+{
+    uint bit = y * BITBOARD_WIDTH;
+    uint word = bit / 32, shift = bit % 32;
+    uint64_t value = board->words[word] >> shift;
+
+    if (shift + BITBOARD_WIDTH > 32 && word + 1 < BITBOARD_WORDS)
+        value |= (uint64_t)board->words[word + 1] << (32 - shift);
+    return (uint32_t)(value & ((1ull << BITBOARD_WIDTH) - 1));
+}
+
+// Próximo bit aceso a partir de from, ou -1. Percorre só as palavras, não as células.
+static inline int bitboard_next(const bitboard_t *board, uint from)
+{
+    for (uint word = from / 32; word < BITBOARD_WORDS; ++word)
+    {
+        uint32_t bits = board->words[word];
+        if (word == from / 32)
+            bits &= ~0u << (from % 32);
+        if (bits)
+            return word * 32 + __builtin_ctz(bits);
+    }
+    return -1;
+}
+
+#endif // BITBOARD_H
@@ -70,3 +70,19 @@ static uint8_t font[] = {
 0x06, 0x09, 0x09, 0x06, 0x00, 0x00, 0x00, 0x00, // °
 0x00, 0x66, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00 // :
 };
+
+// Índice do glifo em font[] para cada código de caractere (0 = glifo vazio).
+// Permite localizar um caractere com uma única leitura em vez de comparações.
+static const uint8_t font_glyph_index[256] = {
+    ['0'] = 1, ['1'] = 2, ['2'] = 3, ['3'] = 4, ['4'] = 5, ['5'] = 6,
+    ['6'] = 7, ['7'] = 8, ['8'] = 9, ['9'] = 10, ['A'] = 11, ['B'] = 12,
+    ['C'] = 13, ['D'] = 14, ['E'] = 15, ['F'] = 16, ['G'] = 17, ['H'] = 18,
+    ['I'] = 19, ['J'] = 20, ['K'] = 21, ['L'] = 22, ['M'] = 23, ['N'] = 24,
+    ['O'] = 25, ['P'] = 26, ['Q'] = 27, ['R'] = 28, ['S'] = 29, ['T'] = 30,
+    ['U'] = 31, ['V'] = 32, ['W'] = 33, ['X'] = 34, ['Y'] = 35, ['Z'] = 36,
+    ['a'] = 37, ['b'] = 38, ['c'] = 39, ['d'] = 40, ['e'] = 41, ['f'] = 42,
+    ['g'] = 43, ['h'] = 44, ['i'] = 45, ['j'] = 46, ['k'] = 47, ['l'] = 48,
+    ['m'] = 49, ['n'] = 50, ['o'] = 51, ['p'] = 52, ['q'] = 53, ['r'] = 54,
+    ['s'] = 55, ['t'] = 56, ['u'] = 57, ['v'] = 58, ['w'] = 59, ['x'] = 60,
+    ['y'] = 61, ['z'] = 62, ['%'] = 63, [0xB0] = 64, [':'] = 65,
+};
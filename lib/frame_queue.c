@@ -0,0 +1,60 @@
+#include "frame_queue.h"
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+
+void frame_queue_init(frame_queue_t *queue)
+{
+    queue->head = 0;
+    queue->tail = 0;
+    queue->dropped_full = 0;
+    queue->dropped_stale = 0;
+    queue->max_depth = 0;
+}
+
+// Quadros publicados e ainda não consumidos.
+uint32_t frame_queue_depth(const frame_queue_t *queue)
+{
+    return queue->head - queue->tail;
+}
+
+// Publica um quadro (núcleo produtor). Com a fila cheia o quadro é descartado:
+// o produtor nunca espera pelo consumidor.
+bool frame_queue_push(frame_queue_t *queue, const frame_t *frame)
+{
+    uint32_t head = queue->head;
+    uint32_t depth = head - queue->tail;
+
+    if (depth >= FRAME_QUEUE_SIZE)
+    {
+        queue->dropped_full++;
+        return false;
+    }
+
+    queue->frames[head & (FRAME_QUEUE_SIZE - 1)] = *frame;
+    __dmb(); // O conteúdo precisa estar visível antes do novo head
+    queue->head = head + 1;
+
+    if (depth + 1 > queue->max_depth)
+        queue->max_depth = depth + 1;
+
+    __sev(); // Acorda o consumidor em __wfe()
+    return true;
+}
+
+// Retira o quadro mais recente (núcleo consumidor); os mais antigos contam como
+// descartados. Retorna false se a fila estiver vazia.
+bool frame_queue_pop_latest(frame_queue_t *queue, frame_t *frame)
+{
+    uint32_t tail = queue->tail;
+    uint32_t head = queue->head;
+
+    if (head == tail)
+        return false;
+
+    __dmb(); // Lê o conteúdo só depois de observar o head
+    *frame = queue->frames[(head - 1) & (FRAME_QUEUE_SIZE - 1)];
+    __dmb(); // Termina a leitura antes de liberar as posições
+    queue->dropped_stale += head - tail - 1;
+    queue->tail = head;
+    return true;
+}
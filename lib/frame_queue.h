@@ -0,0 +1,40 @@
+#ifndef FRAME_QUEUE_H
+#define FRAME_QUEUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "meteors.h"
+
+#define FRAME_QUEUE_SIZE 4 // Potência de 2
+
+// Descrição imutável de um quadro, publicada pelo núcleo 0 e desenhada pelo núcleo 1.
+typedef struct {
+    uint32_t sequence;
+    uint32_t published_us; // time_us_32 na publicação, para medir a latência até o display
+    uint32_t input_us;     // Instante do último botão aplicado, para medir a latência até a matriz
+    uint16_t rect_x, rect_y, rect_width, rect_height; // Retângulo do display OLED
+    bool matrix_update;     // false mantém a matriz como está
+    bool idle;              // Modo ocioso: display com pouco contraste e matriz apagada
+    uint32_t wake_us;       // Instante do último despertar, para medir a latência até o display
+    int8_t spaceship_x;     // Coluna da nave na linha de baixo
+    bitboard_t meteors[METEOR_SPEEDS]; // Meteoros de cada classe de velocidade
+    bitboard_t explosions;  // Colisões do último passo
+} frame_t;
+
+// Fila circular de um produtor e um consumidor, sem travas: o produtor só escreve
+// head e o consumidor só escreve tail.
+typedef struct {
+    frame_t frames[FRAME_QUEUE_SIZE];
+    volatile uint32_t head;      // Próxima posição a escrever (produtor)
+    volatile uint32_t tail;      // Próxima posição a ler (consumidor)
+    volatile uint32_t dropped_full;  // Descartados pelo produtor com a fila cheia
+    volatile uint32_t dropped_stale; // Substituídos por um mais novo antes de serem desenhados
+    volatile uint32_t max_depth;     // Maior ocupação observada (produtor)
+} frame_queue_t;
+
+void frame_queue_init(frame_queue_t *queue);
+bool frame_queue_push(frame_queue_t *queue, const frame_t *frame);
+bool frame_queue_pop_latest(frame_queue_t *queue, frame_t *frame);
+uint32_t frame_queue_depth(const frame_queue_t *queue);
+
+#endif // FRAME_QUEUE_H
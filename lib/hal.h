@@ -0,0 +1,43 @@
+#ifndef HAL_H
+#define HAL_H
+
+// Camada fina sobre os periféricos acessados por DMA, PIO ou registradores: é o que
+// separa os drivers do hardware. Tempo, alarmes, GPIO e PWM continuam usando a API do
+// SDK diretamente; no build de host (host/) essa API é emulada com um relógio virtual.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+
+// Bit de STOP de uma palavra do fluxo I2C (IC_DATA_CMD): encerra a transação.
+#define HAL_I2C_STOP_BIT 0x200
+
+typedef enum {
+    HAL_I2C_IDLE,    // Nenhum envio em andamento
+    HAL_I2C_BUSY,    // Fluxo ainda no barramento
+    HAL_I2C_ABORTED, // O dispositivo não respondeu e o fluxo foi descartado
+} hal_i2c_status_t;
+
+// I2C bloqueante: uma transação com START, endereço, dados e STOP.
+void hal_i2c_write(i2c_inst_t *i2c, uint8_t address, const uint8_t *data, size_t len);
+
+// Fluxo I2C assíncrono: cada palavra é um byte de dados, com HAL_I2C_STOP_BIT no
+// último byte de cada transação. Um fluxo pode conter várias transações seguidas.
+int hal_i2c_stream_init(i2c_inst_t *i2c);
+void hal_i2c_stream_start(int stream, i2c_inst_t *i2c, uint8_t address, const uint16_t *words, size_t count);
+hal_i2c_status_t hal_i2c_stream_status(int stream, i2c_inst_t *i2c);
+// Liga, no núcleo que chama, a interrupção de STOP do I2C durante os fluxos: cada
+// transação que termina no barramento gera um evento, e quem espera o fim do fluxo
+// pode dormir em __wfe. A interrupção é desarmada quando o status deixa de ser BUSY.
+void hal_i2c_stream_enable_wake(i2c_inst_t *i2c);
+
+// Saída WS2812B, enviada sem bloquear. Com uma fita, uma palavra por LED
+// (G << 24 | R << 16 | B << 8), enviada a partir do bit 31. Com LED_STRIPS > 1, fatias de
+// bits: cada byte é um tempo de bit de todas as fitas (bit k = fita k), 24 por LED na
+// ordem de envio, do byte menos significativo de cada palavra para o mais.
+void hal_ws2812_init(uint pin);
+void hal_ws2812_start(const uint32_t *words, size_t count);
+
+#endif // HAL_H
@@ -0,0 +1,135 @@
+#include "hal.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "hardware/pio.h"
+#include "led_matrix.pio.h"
+#include "led_matrix_geometry.h"
+
+PIO led_matrix_pio;        // Bloco PIO da matriz de LEDs.
+uint sm;                   // Número da máquina state machine.
+static int led_matrix_dma; // Canal DMA ligado à FIFO da máquina PIO.
+static bool i2c_stream_wake[2]; // Instâncias I2C com a interrupção de STOP ligada.
+
+void hal_i2c_write(i2c_inst_t *i2c, uint8_t address, const uint8_t *data, size_t len)
+{
+    i2c_write_blocking(i2c, address, data, len, false);
+}
+
+// Reserva um canal DMA que escreve palavras de 16 bits no IC_DATA_CMD, no ritmo do
+// DREQ de TX do I2C.
+int hal_i2c_stream_init(i2c_inst_t *i2c)
+{
+    int channel = dma_claim_unused_channel(true);
+    dma_channel_config config = dma_channel_get_default_config(channel);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_16);
+    channel_config_set_read_increment(&config, true);
+    channel_config_set_write_increment(&config, false);
+    channel_config_set_dreq(&config, i2c_get_dreq(i2c, true));
+    dma_channel_configure(channel, &config, &i2c_get_hw(i2c)->data_cmd, NULL, 0, false);
+    return channel;
+}
+
+void hal_i2c_stream_start(int stream, i2c_inst_t *i2c, uint8_t address, const uint16_t *words, size_t count)
+{
+    i2c_hw_t *hw = i2c_get_hw(i2c);
+    hw->enable = 0;
+    hw->tar = address;
+    hw->enable = 1;
+
+    // Arma a interrupção de STOP só durante o fluxo: as escritas bloqueantes do SDK
+    // esperam pelo STOP_DET e não podem tê-lo limpo por uma interrupção.
+    if (i2c_stream_wake[i2c_hw_index(i2c)])
+    {
+        (void)hw->clr_stop_det;
+        hw->intr_mask = I2C_IC_INTR_MASK_M_STOP_DET_BITS;
+    }
+
+    dma_channel_transfer_from_buffer_now(stream, words, count);
+}
+
+// O DMA termina antes do barramento: é preciso esperar a FIFO de TX esvaziar e o
+// controlador ficar ocioso.
+hal_i2c_status_t hal_i2c_stream_status(int stream, i2c_inst_t *i2c)
+{
+    i2c_hw_t *hw = i2c_get_hw(i2c);
+
+    // Um NACK descarta a FIFO e trava o DREQ; aborta o resto do fluxo.
+    if (hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS)
+    {
+        dma_channel_abort(stream);
+        (void)hw->clr_tx_abrt;
+        hw->intr_mask = 0;
+        return HAL_I2C_ABORTED;
+    }
+
+    if (dma_channel_is_busy(stream))
+        return HAL_I2C_BUSY;
+
+    if (!(hw->status & I2C_IC_STATUS_TFE_BITS) || (hw->status & I2C_IC_STATUS_ACTIVITY_BITS))
+        return HAL_I2C_BUSY;
+
+    hw->intr_mask = 0; // Fim do fluxo: desarma a interrupção de STOP
+    return HAL_I2C_IDLE;
+}
+
+// Limpa o STOP das duas instâncias e sinaliza um evento para quem dorme em __wfe.
+static void hal_i2c_stop_handler(void)
+{
+    (void)i2c_get_hw(i2c0)->clr_stop_det;
+    (void)i2c_get_hw(i2c1)->clr_stop_det;
+    __sev();
+}
+
+void hal_i2c_stream_enable_wake(i2c_inst_t *i2c)
+{
+    uint index = i2c_hw_index(i2c);
+
+    i2c_get_hw(i2c)->intr_mask = 0;
+    i2c_stream_wake[index] = true;
+    irq_set_exclusive_handler(I2C0_IRQ + index, hal_i2c_stop_handler);
+    irq_set_enabled(I2C0_IRQ + index, true);
+}
+
+// Inicializa a máquina PIO e o canal DMA que alimenta sua FIFO. Com LED_STRIPS > 1,
+// carrega o programa paralelo nos pinos pin a pin + LED_STRIPS - 1.
+void hal_ws2812_init(uint pin)
+{
+    // Cria programa PIO.
+#if LED_STRIPS > 1
+    uint offset = pio_add_program(pio0, &led_matrix_parallel_program);
+#else
+    uint offset = pio_add_program(pio0, &led_matrix_program);
+#endif
+    led_matrix_pio = pio0;
+
+    // Toma posse de uma máquina PIO.
+    sm = pio_claim_unused_sm(led_matrix_pio, false);
+    if (sm < 0)
+    {
+        led_matrix_pio = pio1;
+        sm = pio_claim_unused_sm(led_matrix_pio, true); // Se nenhuma máquina estiver livre, panic!
+    }
+
+    // Inicia programa na máquina PIO obtida.
+#if LED_STRIPS > 1
+    led_matrix_parallel_program_init(led_matrix_pio, sm, offset, pin, LED_STRIPS, 800000.f);
+#else
+    led_matrix_program_init(led_matrix_pio, sm, offset, pin, 800000.f);
+#endif
+
+    // O DMA alimenta a FIFO com uma palavra por pixel (ou quatro fatias, em paralelo), no
+    // ritmo do DREQ da máquina.
+    led_matrix_dma = dma_claim_unused_channel(true);
+    dma_channel_config config = dma_channel_get_default_config(led_matrix_dma);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_32);
+    channel_config_set_read_increment(&config, true);
+    channel_config_set_write_increment(&config, false);
+    channel_config_set_dreq(&config, pio_get_dreq(led_matrix_pio, sm, true));
+    dma_channel_configure(led_matrix_dma, &config, &led_matrix_pio->txf[sm], NULL, 0, false);
+}
+
+void hal_ws2812_start(const uint32_t *words, size_t count)
+{
+    dma_channel_transfer_from_buffer_now(led_matrix_dma, words, count);
+}
@@ -0,0 +1,129 @@
+#include "input.h"
+#include "hardware/sync.h"
+
+static input_pin_t pins_state[INPUT_MAX_PINS];
+static uint8_t pin_count = 0;
+
+// Fila de eventos de um produtor (o alarme de trepidação) e um consumidor (a
+// tarefa que chama input_poll), sem travas.
+static input_event_t queue[INPUT_QUEUE_SIZE];
+static volatile uint32_t queue_head = 0;
+static volatile uint32_t queue_tail = 0;
+static volatile uint32_t queue_dropped = 0;
+
+static void input_push(const input_event_t *event)
+{
+    uint32_t head = queue_head;
+
+    if (head - queue_tail >= INPUT_QUEUE_SIZE)
+    {
+        queue_dropped++;
+        return;
+    }
+
+    queue[head & (INPUT_QUEUE_SIZE - 1)] = *event;
+    __dmb(); // O evento precisa estar visível antes do novo head
+    queue_head = head + 1;
+    __sev();
+}
+
+// Alarme de trepidação: enquanto houver bordas recentes, adia a decisão; depois lê
+// o nível e publica o evento se ele mudou.
+static int64_t input_debounce_callback(alarm_id_t id, void *user_data)
+{
+    input_pin_t *state = user_data;
+    uint32_t quiet_us = time_us_32() - state->last_edge_us;
+
+    if (quiet_us < INPUT_DEBOUNCE_US)
+        return INPUT_DEBOUNCE_US - quiet_us; // Reagenda a partir de agora
+
+    bool level = gpio_get(state->pin);
+    state->settling = false;
+
+    if (level != state->level)
+    {
+        state->level = level;
+        input_event_t event = {
+            .pin = state->pin,
+            .pressed = !level,
+            .timestamp_us = state->first_edge_us,
+        };
+        input_push(&event);
+    }
+
+    return 0;
+}
+
+// Interrupção dos botões: algumas escritas e, na primeira borda, o alarme
+static void input_gpio_callback(uint gpio, uint32_t events)
+{
+    uint32_t now = time_us_32();
+
+    for (uint8_t i = 0; i < pin_count; ++i)
+    {
+        input_pin_t *state = &pins_state[i];
+        if (state->pin != gpio)
+            continue;
+
+        state->last_edge_us = now;
+        if (!state->settling)
+        {
+            state->first_edge_us = now;
+            state->settling = add_alarm_in_us(INPUT_DEBOUNCE_US, input_debounce_callback, state, true) > 0;
+        }
+        return;
+    }
+}
+
+// Registra os botões (já configurados como entrada com pull-up) e habilita as
+// interrupções das duas bordas.
+void input_init(const uint8_t *pins, uint8_t count)
+{
+    pin_count = MIN(count, INPUT_MAX_PINS);
+
+    for (uint8_t i = 0; i < pin_count; ++i)
+    {
+        pins_state[i].pin = pins[i];
+        pins_state[i].level = gpio_get(pins[i]);
+        pins_state[i].settling = false;
+
+        if (i == 0)
+            gpio_set_irq_enabled_with_callback(pins[i], GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true, &input_gpio_callback);
+        else
+            gpio_set_irq_enabled(pins[i], GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true);
+    }
+}
+
+// Retira o evento mais antigo. Retorna false se a fila estiver vazia.
+bool input_poll(input_event_t *event)
+{
+    uint32_t tail = queue_tail;
+
+    if (tail == queue_head)
+        return false;
+
+    __dmb(); // Lê o evento só depois de observar o head
+    *event = queue[tail & (INPUT_QUEUE_SIZE - 1)];
+    __dmb(); // Termina a leitura antes de liberar a posição
+    queue_tail = tail + 1;
+    return true;
+}
+
+// Copia o evento mais antigo sem retirá-lo. Retorna false se a fila estiver vazia.
+bool input_peek(input_event_t *event)
+{
+    uint32_t tail = queue_tail;
+
+    if (tail == queue_head)
+        return false;
+
+    __dmb(); // Lê o evento só depois de observar o head
+    *event = queue[tail & (INPUT_QUEUE_SIZE - 1)];
+    return true;
+}
+
+// Eventos descartados com a fila cheia
+uint32_t input_dropped(void)
+{
+    return queue_dropped;
+}
@@ -0,0 +1,34 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+
+#define INPUT_MAX_PINS 4
+#define INPUT_QUEUE_SIZE 16     // Potência de 2
+#define INPUT_DEBOUNCE_US 20000 // Tempo sem bordas para o nível contar como estável
+
+// Evento de botão já sem trepidação. Os botões são ativos em nível baixo (pull-up).
+typedef struct {
+    uint8_t pin;
+    bool pressed;          // true no aperto, false ao soltar
+    uint32_t timestamp_us; // time_us_32 da primeira borda da transição
+} input_event_t;
+
+// Estado de trepidação de um pino. A interrupção do GPIO só anota o instante da
+// borda e arma o alarme; o alarme decide quando o nível está estável.
+typedef struct {
+    uint8_t pin;
+    bool level;                        // Último nível estável
+    volatile bool settling;            // Alarme armado, nível ainda instável
+    volatile uint32_t first_edge_us;   // Primeira borda da transição em andamento
+    volatile uint32_t last_edge_us;    // Borda mais recente
+} input_pin_t;
+
+void input_init(const uint8_t *pins, uint8_t count);
+bool input_poll(input_event_t *event);
+bool input_peek(input_event_t *event);
+uint32_t input_dropped(void);
+
+#endif // INPUT_H
@@ -0,0 +1,114 @@
+#include "joystick.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/clocks.h"
+
+// Anel escrito continuamente pelo DMA. O alinhamento ao tamanho é exigido pelo modo
+// de anel do DMA, e o tamanho par mantém cada eixo sempre na mesma paridade de posição.
+static uint16_t joystick_ring[JOYSTICK_RING_SAMPLES] __attribute__((aligned(1u << JOYSTICK_RING_BITS)));
+
+static joystick_config_t joystick_config;
+static int joystick_data_dma;      // Copia a FIFO do ADC para o anel
+static int joystick_control_dma;   // Rearma o canal de dados quando a contagem acaba
+static uint32_t joystick_reload_count = 0xFFFF;
+static uint8_t x_parity;           // Paridade das posições do anel com o eixo X
+static int32_t filtered_x, filtered_y;
+static bool filter_ready = false;
+
+// Inicia a amostragem em segundo plano: o ADC alterna entre os dois eixos e o DMA
+// grava cada conversão no anel, sem participação da CPU.
+void joystick_init(const joystick_config_t *config)
+{
+    joystick_config = *config;
+    if (joystick_config.oversampling == 0)
+        joystick_config.oversampling = 1;
+    if (joystick_config.oversampling > JOYSTICK_RING_SAMPLES / 2)
+        joystick_config.oversampling = JOYSTICK_RING_SAMPLES / 2;
+
+    // O round robin percorre as entradas em ordem crescente a partir da menor.
+    uint8_t first_input = MIN(config->x_input, config->y_input);
+    x_parity = config->x_input == first_input ? 0 : 1;
+
+    adc_run(false);
+    adc_select_input(first_input);
+    adc_set_round_robin((1u << config->x_input) | (1u << config->y_input));
+    adc_fifo_setup(true, true, 1, false, false);
+    joystick_set_sample_rate(config->sample_rate_hz);
+    adc_fifo_drain();
+
+    joystick_data_dma = dma_claim_unused_channel(true);
+    joystick_control_dma = dma_claim_unused_channel(true);
+
+    dma_channel_config data = dma_channel_get_default_config(joystick_data_dma);
+    channel_config_set_transfer_data_size(&data, DMA_SIZE_16);
+    channel_config_set_read_increment(&data, false);
+    channel_config_set_write_increment(&data, true);
+    channel_config_set_ring(&data, true, JOYSTICK_RING_BITS);
+    channel_config_set_dreq(&data, DREQ_ADC);
+    channel_config_set_chain_to(&data, joystick_control_dma);
+
+    dma_channel_config control = dma_channel_get_default_config(joystick_control_dma);
+    channel_config_set_transfer_data_size(&control, DMA_SIZE_32);
+    channel_config_set_read_increment(&control, false);
+    channel_config_set_write_increment(&control, false);
+
+    dma_channel_configure(joystick_control_dma, &control, &dma_hw->ch[joystick_data_dma].al1_transfer_count_trig,
+                          &joystick_reload_count, 1, false);
+    dma_channel_configure(joystick_data_dma, &data, joystick_ring, &adc_hw->fifo, joystick_reload_count, true);
+
+    adc_run(true);
+}
+
+// Troca a taxa de conversão sem parar a amostragem. Taxas baixas economizam energia; a
+// janela somada por joystick_read fica proporcionalmente mais longa. Taxas abaixo de
+// JOYSTICK_MIN_SAMPLE_RATE_HZ não cabem no divisor e são limitadas a ela.
+void joystick_set_sample_rate(uint32_t sample_rate_hz)
+{
+    if (sample_rate_hz < JOYSTICK_MIN_SAMPLE_RATE_HZ)
+        sample_rate_hz = JOYSTICK_MIN_SAMPLE_RATE_HZ;
+    joystick_config.sample_rate_hz = sample_rate_hz;
+    adc_set_clkdiv((float)clock_get_hz(clk_adc) / sample_rate_hz - 1.0f);
+}
+
+// Aplica a zona morta em torno do centro.
+static uint16_t joystick_dead_zone(int32_t value)
+{
+    int32_t delta = value - JOYSTICK_ADC_CENTER;
+    if (delta < joystick_config.dead_zone && delta > -(int32_t)joystick_config.dead_zone)
+        return JOYSTICK_ADC_CENTER;
+    return (uint16_t)value;
+}
+
+// Lê os valores filtrados do joystick. Não acessa o ADC: soma as amostras mais
+// recentes do anel, atrás da posição atual de escrita do DMA. Deve ser chamada
+// sempre do mesmo contexto, que é o dono do estado do filtro.
+void joystick_read(uint16_t *x_value, uint16_t *y_value)
+{
+    uint32_t write_addr = dma_hw->ch[joystick_data_dma].write_addr;
+    uint32_t next = (write_addr - (uint32_t)(uintptr_t)joystick_ring) / sizeof(uint16_t);
+    uint32_t sum[2] = {0, 0};
+
+    // As posições pares e ímpares guardam eixos diferentes.
+    for (uint32_t i = 1; i <= 2u * joystick_config.oversampling; ++i)
+    {
+        uint32_t slot = (next - i) & (JOYSTICK_RING_SAMPLES - 1);
+        sum[slot & 1] += joystick_ring[slot] & 0x0FFF;
+    }
+
+    int32_t x = sum[x_parity] / joystick_config.oversampling;
+    int32_t y = sum[x_parity ^ 1] / joystick_config.oversampling;
+
+    if (!filter_ready)
+    {
+        filtered_x = x << 8;
+        filtered_y = y << 8;
+        filter_ready = true;
+    }
+
+    // Filtro IIR em ponto fixo com 8 bits de fração.
+    filtered_x += ((x << 8) - filtered_x) >> joystick_config.filter_shift;
+    filtered_y += ((y << 8) - filtered_y) >> joystick_config.filter_shift;
+
+    *x_value = joystick_dead_zone(filtered_x >> 8);
+    *y_value = joystick_dead_zone(filtered_y >> 8);
+}
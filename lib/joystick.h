@@ -0,0 +1,26 @@
+#ifndef JOYSTICK_H
+#define JOYSTICK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+
+#define JOYSTICK_RING_BITS 7                                          // log2 do tamanho do anel em bytes
+#define JOYSTICK_RING_SAMPLES ((1u << JOYSTICK_RING_BITS) / sizeof(uint16_t)) // Amostras dos dois eixos, intercaladas
+#define JOYSTICK_ADC_CENTER 2048
+#define JOYSTICK_MIN_SAMPLE_RATE_HZ 733 // 48 MHz / (1 + 65535.996): o divisor do ADC tem 16 bits inteiros
+
+typedef struct {
+    uint8_t x_input;         // Entrada do ADC do eixo X
+    uint8_t y_input;         // Entrada do ADC do eixo Y
+    uint32_t sample_rate_hz; // Conversões por segundo, somando os dois eixos
+    uint8_t oversampling;    // Amostras mais recentes de cada eixo somadas por leitura (até JOYSTICK_RING_SAMPLES / 2)
+    uint8_t filter_shift;    // Filtro IIR: y += (x - y) >> filter_shift; 0 desliga o filtro
+    uint16_t dead_zone;      // Desvios do centro menores que isso são lidos como centro
+} joystick_config_t;
+
+void joystick_init(const joystick_config_t *config);
+void joystick_read(uint16_t *x_value, uint16_t *y_value);
+void joystick_set_sample_rate(uint32_t sample_rate_hz);
+
+#endif // JOYSTICK_H
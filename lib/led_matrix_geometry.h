@@ -0,0 +1,88 @@
+#ifndef LED_MATRIX_GEOMETRY_H
+#define LED_MATRIX_GEOMETRY_H
+
+// Geometria da matriz de LEDs, definida em tempo de compilação. A matriz é um mosaico
+// de LED_PANELS_X x LED_PANELS_Y painéis iguais ligados em uma única fita; todos os
+// valores podem ser trocados com -D no build.
+
+// Painel: dimensões e caminho da fita dentro dele. Com LED_PANEL_SERPENTINE a fita
+// alterna o sentido a cada linha (ou coluna, com LED_PANEL_COLUMN_MAJOR); sem ela,
+// toda linha começa do mesmo lado.
+#ifndef LED_PANEL_WIDTH
+#define LED_PANEL_WIDTH 5
+#endif
+#ifndef LED_PANEL_HEIGHT
+#define LED_PANEL_HEIGHT 5
+#endif
+#ifndef LED_PANEL_SERPENTINE
+#define LED_PANEL_SERPENTINE 1
+#endif
+#ifndef LED_PANEL_COLUMN_MAJOR
+#define LED_PANEL_COLUMN_MAJOR 0
+#endif
+
+// Mosaico: os painéis são encadeados linha a linha a partir do canto de baixo à
+// esquerda; com LED_PANELS_SERPENTINE as linhas ímpares de painéis voltam da direita
+// para a esquerda.
+#ifndef LED_PANELS_X
+#define LED_PANELS_X 1
+#endif
+#ifndef LED_PANELS_Y
+#define LED_PANELS_Y 1
+#endif
+#ifndef LED_PANELS_SERPENTINE
+#define LED_PANELS_SERPENTINE 1
+#endif
+
+// Rotação de montagem de cada painel na ordem da cadeia, em passos de 90° no sentido
+// horário (0 a 3). Painéis não quadrados só aceitam 0 ou 2. Os omitidos valem 0.
+#ifndef LED_PANEL_ROTATIONS
+#define LED_PANEL_ROTATIONS {0}
+#endif
+
+#define LED_PANEL_COUNT (LED_PANELS_X * LED_PANELS_Y)
+#define LED_PANEL_LEDS (LED_PANEL_WIDTH * LED_PANEL_HEIGHT)
+
+// Geometria física da matriz inteira
+#define LED_MATRIX_WIDTH (LED_PANEL_WIDTH * LED_PANELS_X)
+#define LED_MATRIX_HEIGHT (LED_PANEL_HEIGHT * LED_PANELS_Y)
+#define LED_MATRIX_COUNT (LED_MATRIX_WIDTH * LED_MATRIX_HEIGHT)
+
+// Fitas em paralelo: a cadeia de painéis é dividida em LED_STRIPS trechos iguais, cada
+// um no seu pino a partir de LED_MATRIX_PIN, todos enviados ao mesmo tempo por uma
+// única máquina PIO. O tempo de envio passa a depender só de LED_STRIP_LEDS.
+#ifndef LED_STRIPS
+#define LED_STRIPS 1
+#endif
+
+#if LED_STRIPS < 1 || LED_STRIPS > 8
+#error "LED_STRIPS precisa estar entre 1 e 8"
+#endif
+#if LED_PANEL_COUNT % LED_STRIPS
+#error "LED_STRIPS precisa dividir o número de painéis"
+#endif
+
+#define LED_STRIP_LEDS (LED_MATRIX_COUNT / LED_STRIPS)
+
+// Orientação das coordenadas lógicas (x, y) sobre a matriz física.
+// Rotação em passos de 90° no sentido horário (0 a 3), aplicada após o espelhamento.
+#ifndef LED_MATRIX_ROTATION
+#define LED_MATRIX_ROTATION 0
+#endif
+#ifndef LED_MATRIX_FLIP_X
+#define LED_MATRIX_FLIP_X 0
+#endif
+#ifndef LED_MATRIX_FLIP_Y
+#define LED_MATRIX_FLIP_Y 0
+#endif
+
+// Dimensões lógicas: trocadas quando a rotação é de 90° ou 270°.
+#if LED_MATRIX_ROTATION % 2
+#define LED_MATRIX_LOGICAL_WIDTH LED_MATRIX_HEIGHT
+#define LED_MATRIX_LOGICAL_HEIGHT LED_MATRIX_WIDTH
+#else
+#define LED_MATRIX_LOGICAL_WIDTH LED_MATRIX_WIDTH
+#define LED_MATRIX_LOGICAL_HEIGHT LED_MATRIX_HEIGHT
+#endif
+
+#endif // LED_MATRIX_GEOMETRY_H
@@ -1,7 +1,7 @@
 #include "led_matrix_numbers.h"
 
 // Definição dos números de 0 a 9 na matriz de LEDs
-int led_matrix_numbers[10][LED_MATRIX_COUNT] = {
+int led_matrix_numbers[10][LED_NUMBER_LEDS] = {
     {0, 1, 1, 1, 0, 0, 1, 0, 1, 0, 0, 1, 0, 1, 0, 0, 1, 0, 1, 0, 0, 1, 1, 1, 0},
     {0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 0, 1, 0, 0},
     {0, 1, 1, 1, 0, 0, 1, 0, 0, 0, 0, 1, 1, 1, 0, 0, 0, 0, 1, 0, 0, 1, 1, 1, 0},
@@ -14,16 +14,17 @@ int led_matrix_numbers[10][LED_MATRIX_COUNT] = {
     {0, 1, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1, 1, 1, 0, 0, 1, 0, 1, 0, 0, 1, 1, 1, 0},
 };
 
-// Definição das cores para os números
+// Definição das cores para os números, em escala perceptual: o brilho global
+// (WS2812B_BRIGHTNESS) as deixa tão fracas quanto antes
 int led_matrix_number_colors[10][3] = {
-    {15, 0, 0},   // Vermelho mais fraco
-    {0, 15, 0},   // Verde mais fraco
-    {0, 0, 15},   // Azul mais fraco
-    {15, 15, 0},  // Amarelo mais fraco
-    {0, 15, 15},  // Ciano mais fraco
-    {15, 0, 15},  // Magenta mais fraco
-    {15, 15, 15}, // Branco acinzentado
-    {15, 9, 0},   // Laranja mais fraco
-    {7, 0, 7},    // Roxo mais fraco
-    {9, 2, 2}     // Marrom mais fraco
+    {248, 0, 0},     // Vermelho mais fraco
+    {0, 248, 0},     // Verde mais fraco
+    {0, 0, 248},     // Azul mais fraco
+    {248, 248, 0},   // Amarelo mais fraco
+    {0, 248, 248},   // Ciano mais fraco
+    {248, 0, 248},   // Magenta mais fraco
+    {248, 248, 248}, // Branco acinzentado
+    {248, 196, 0},   // Laranja mais fraco
+    {175, 0, 175},   // Roxo mais fraco
+    {196, 99, 99}    // Marrom mais fraco
 };
@@ -1,10 +1,16 @@
 #ifndef LED_MATRIX_NUMBERS_H
 #define LED_MATRIX_NUMBERS_H
 
-#define LED_MATRIX_COUNT 25
+#include "led_matrix_geometry.h"
+
+// Os números são desenhos de 5x5 guardados na ordem da fita de um painel 5x5 em
+// serpentina: a linha 0 da esquerda para a direita, a linha 1 da direita para a
+// esquerda e assim por diante.
+#define LED_NUMBER_SIZE 5
+#define LED_NUMBER_LEDS (LED_NUMBER_SIZE * LED_NUMBER_SIZE)
 
 // Declaração dos arrays (sem definição!)
-extern int led_matrix_numbers[10][LED_MATRIX_COUNT];
+extern int led_matrix_numbers[10][LED_NUMBER_LEDS];
 extern int led_matrix_number_colors[10][3];
 
 #endif // LED_MATRIX_H
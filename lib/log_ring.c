@@ -0,0 +1,89 @@
+#include <stdio.h>
+
+#include "log_ring.h"
+#include "hardware/sync.h"
+
+static log_ring_t rings[2]; // Um anel por núcleo
+static uint32_t dropped_reported = 0;
+
+// Grava um registro no anel do núcleo atual. As interrupções ficam mascaradas só
+// durante as escritas, para que uma interrupção não intercale com a tarefa que
+// ela interrompeu; entre núcleos não há disputa.
+void log_push(const char *format, uint8_t argc, int a0, int a1, int a2)
+{
+    log_ring_t *ring = &rings[get_core_num()];
+    uint32_t status = save_and_disable_interrupts();
+    uint32_t head = ring->head;
+
+    if (head - ring->tail >= LOG_RING_SIZE)
+    {
+        ring->dropped++;
+        restore_interrupts(status);
+        return;
+    }
+
+    log_record_t *record = &ring->records[head & (LOG_RING_SIZE - 1)];
+    record->format = format;
+    record->timestamp_us = time_us_32();
+    record->argc = argc;
+    record->args[0] = a0;
+    record->args[1] = a1;
+    record->args[2] = a2;
+    __dmb(); // O registro precisa estar visível antes do novo head
+    ring->head = head + 1;
+
+    restore_interrupts(status);
+}
+
+// Formata e imprime todos os registros pendentes dos dois núcleos, em ordem de
+// tempo. Deve rodar fora de interrupção, no tempo ocioso de um único consumidor.
+// Retorna true se algo foi impresso.
+bool log_drain(void)
+{
+    bool printed = false;
+
+    while (true)
+    {
+        log_ring_t *oldest = NULL;
+
+        for (int core = 0; core < 2; ++core)
+        {
+            log_ring_t *ring = &rings[core];
+            if (ring->head == ring->tail)
+                continue;
+
+            __dmb(); // Lê o registro só depois de observar o head
+            if (!oldest ||
+                (int32_t)(ring->records[ring->tail & (LOG_RING_SIZE - 1)].timestamp_us -
+                          oldest->records[oldest->tail & (LOG_RING_SIZE - 1)].timestamp_us) < 0)
+                oldest = ring;
+        }
+
+        if (!oldest)
+            break;
+
+        const log_record_t *record = &oldest->records[oldest->tail & (LOG_RING_SIZE - 1)];
+        printf("[%10lu] ", (unsigned long)record->timestamp_us);
+        printf(record->format, record->args[0], record->args[1], record->args[2]);
+        printf("\n");
+        __dmb(); // Termina a leitura antes de liberar a posição
+        oldest->tail++;
+        printed = true;
+    }
+
+    uint32_t dropped = log_dropped();
+    if (dropped != dropped_reported)
+    {
+        printf("[log] %lu registros descartados\n", (unsigned long)(dropped - dropped_reported));
+        dropped_reported = dropped;
+        printed = true;
+    }
+
+    return printed;
+}
+
+// Total de registros descartados com o anel cheio, somando os dois núcleos
+uint32_t log_dropped(void)
+{
+    return rings[0].dropped + rings[1].dropped;
+}
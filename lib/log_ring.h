@@ -0,0 +1,40 @@
+#ifndef LOG_RING_H
+#define LOG_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+
+#define LOG_RING_SIZE 32 // Registros por núcleo, potência de 2
+#define LOG_MAX_ARGS 3
+
+// Registro binário de tamanho fixo. O formato é um literal de string, que serve de
+// identificador da mensagem: nada é formatado no momento do registro.
+typedef struct {
+    const char *format;       // printf sem o '\n' final; argumentos impressos como int
+    uint32_t timestamp_us;    // time_us_32 no registro
+    uint8_t argc;
+    int args[LOG_MAX_ARGS];
+} log_record_t;
+
+// Um anel por núcleo, com um produtor (o próprio núcleo, dentro ou fora de
+// interrupção) e um consumidor (quem chama log_drain). Cheio, o registro é
+// descartado e contado; o produtor nunca espera.
+typedef struct {
+    log_record_t records[LOG_RING_SIZE];
+    volatile uint32_t head;    // Próxima posição a escrever (produtor)
+    volatile uint32_t tail;    // Próxima posição a ler (consumidor)
+    volatile uint32_t dropped; // Registros descartados com o anel cheio (produtor)
+} log_ring_t;
+
+void log_push(const char *format, uint8_t argc, int a0, int a1, int a2);
+bool log_drain(void);
+uint32_t log_dropped(void);
+
+// Registro adiado, seguro em interrupções: custa algumas escritas na memória.
+#define LOG0(format) log_push(format, 0, 0, 0, 0)
+#define LOG1(format, a0) log_push(format, 1, (int)(a0), 0, 0)
+#define LOG2(format, a0, a1) log_push(format, 2, (int)(a0), (int)(a1), 0)
+#define LOG3(format, a0, a1, a2) log_push(format, 3, (int)(a0), (int)(a1), (int)(a2))
+
+#endif // LOG_RING_H
@@ -0,0 +1,91 @@
+#include "meteors.h"
+
+static const uint8_t meteor_periods[METEOR_SPEEDS] = METEOR_PERIODS;
+
+void meteor_field_init(meteor_field_t *field)
+{
+    for (int speed = 0; speed < METEOR_SPEEDS; ++speed)
+        field->period[speed] = meteor_periods[speed];
+    meteor_field_clear(field);
+}
+
+// Remove todos os meteoros e explosões
+void meteor_field_clear(meteor_field_t *field)
+{
+    for (int speed = 0; speed < METEOR_SPEEDS; ++speed)
+    {
+        bitboard_clear(&field->layers[speed]);
+        field->countdown[speed] = field->period[speed];
+    }
+    bitboard_clear(&field->explosions);
+}
+
+// Colunas da linha do topo livres em todas as camadas, uma por bit
+uint32_t meteor_spawn_columns(const meteor_field_t *field)
+{
+    uint32_t taken = 0;
+
+    for (int speed = 0; speed < METEOR_SPEEDS; ++speed)
+        taken |= bitboard_row(&field->layers[speed], BITBOARD_HEIGHT - 1);
+    return ~taken & ((1ull << BITBOARD_WIDTH) - 1);
+}
+
+// Cria um meteoro no topo da coluna x. Falha se a célula já estiver ocupada.
+bool meteor_spawn(meteor_field_t *field, uint x, uint speed)
+{
+    if (x >= BITBOARD_WIDTH || speed >= METEOR_SPEEDS || !(meteor_spawn_columns(field) >> x & 1))
+        return false;
+
+    bitboard_set(&field->layers[speed], x, BITBOARD_HEIGHT - 1);
+    return true;
+}
+
+// União de todas as camadas
+void meteor_occupancy(const meteor_field_t *field, bitboard_t *occupancy)
+{
+    *occupancy = field->layers[0];
+    for (int speed = 1; speed < METEOR_SPEEDS; ++speed)
+        bitboard_or(occupancy, &field->layers[speed]);
+}
+
+// Destrói os meteoros que estão sobre as células de targets e marca as explosões.
+// Retorna quantos meteoros foram atingidos.
+uint meteor_collide(meteor_field_t *field, const bitboard_t *targets)
+{
+    uint hits = 0;
+
+    bitboard_clear(&field->explosions);
+    for (int speed = 0; speed < METEOR_SPEEDS; ++speed)
+    {
+        bitboard_t hit = field->layers[speed];
+        bitboard_and(&hit, targets);
+        hits += bitboard_count(&hit);
+        bitboard_andnot(&field->layers[speed], &hit);
+        bitboard_or(&field->explosions, &hit);
+    }
+
+    return hits;
+}
+
+// Um passo do jogo: cada classe cujo período venceu desce uma linha inteira.
+// Os meteoros da linha 0 saem do campo.
+void meteor_step(meteor_field_t *field)
+{
+    for (int speed = 0; speed < METEOR_SPEEDS; ++speed)
+    {
+        if (--field->countdown[speed] > 0)
+            continue;
+
+        field->countdown[speed] = field->period[speed];
+        bitboard_shift_down(&field->layers[speed]);
+    }
+}
+
+uint meteor_count(const meteor_field_t *field)
+{
+    uint count = 0;
+
+    for (int speed = 0; speed < METEOR_SPEEDS; ++speed)
+        count += bitboard_count(&field->layers[speed]);
+    return count;
+}
@@ -0,0 +1,35 @@
+#ifndef METEORS_H
+#define METEORS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "bitboard.h"
+
+// Períodos das classes de velocidade, em passos do jogo por linha.
+#ifndef METEOR_PERIODS
+#define METEOR_PERIODS {1, 2}
+#endif
+#define METEOR_SPEEDS 2
+
+// Campo de meteoros em estrutura de arrays: cada meteoro é um bit na camada da sua
+// classe de velocidade. Meteoros da mesma classe descem juntos, então uma camada
+// inteira anda com um único deslocamento e nunca sobrepõe dois meteoros; classes
+// diferentes podem passar pela mesma célula. Cabem até BITBOARD_BITS meteoros por
+// classe.
+typedef struct {
+    bitboard_t layers[METEOR_SPEEDS]; // Ocupação de cada classe
+    uint8_t period[METEOR_SPEEDS];    // Passos por linha
+    uint8_t countdown[METEOR_SPEEDS]; // Passos até a próxima descida
+    bitboard_t explosions;            // Células atingidas no último meteor_collide
+} meteor_field_t;
+
+void meteor_field_init(meteor_field_t *field);
+void meteor_field_clear(meteor_field_t *field);
+bool meteor_spawn(meteor_field_t *field, uint x, uint speed);
+uint32_t meteor_spawn_columns(const meteor_field_t *field);
+void meteor_occupancy(const meteor_field_t *field, bitboard_t *occupancy);
+uint meteor_collide(meteor_field_t *field, const bitboard_t *targets);
+void meteor_step(meteor_field_t *field);
+uint meteor_count(const meteor_field_t *field);
+
+#endif // METEORS_H
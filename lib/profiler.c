@@ -0,0 +1,100 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "profiler.h"
+
+#if PROFILE_ENABLED
+
+static profile_stats_t stats[PROFILE_STAGE_COUNT];
+
+static const char *const stage_names[PROFILE_STAGE_COUNT] = {
+    [PROFILE_INPUT] = "input",
+    [PROFILE_GAME_TICK] = "game_tick",
+    [PROFILE_PUBLISH] = "publish",
+    [PROFILE_OLED_DRAW] = "oled_draw",
+    [PROFILE_OLED_FLUSH] = "oled_flush",
+    [PROFILE_MATRIX] = "matrix",
+    [PROFILE_FRAME] = "frame",
+    [PROFILE_INPUT_LATENCY] = "input_lat",
+    [PROFILE_WAKE_LATENCY] = "wake_lat",
+};
+
+void profile_set_budget(profile_stage_t stage, uint32_t budget_us)
+{
+    stats[stage].budget_us = budget_us;
+}
+
+void profile_record(profile_stage_t stage, uint32_t duration_us)
+{
+    profile_stats_t *s = &stats[stage];
+    uint bucket = duration_us ? 32 - __builtin_clz(duration_us) : 0;
+
+    if (bucket >= PROFILE_BUCKETS)
+        bucket = PROFILE_BUCKETS - 1;
+
+    s->buckets[bucket]++;
+    if (s->count == 0 || duration_us < s->min_us)
+        s->min_us = duration_us;
+    if (duration_us > s->max_us)
+        s->max_us = duration_us;
+    if (s->budget_us && duration_us > s->budget_us)
+        s->overruns++;
+    s->count++;
+}
+
+// Zera as contagens e mantém os orçamentos
+void profile_reset(void)
+{
+    for (int i = 0; i < PROFILE_STAGE_COUNT; ++i)
+    {
+        uint32_t budget_us = stats[i].budget_us;
+        memset(&stats[i], 0, sizeof(stats[i]));
+        stats[i].budget_us = budget_us;
+    }
+}
+
+// Percentil 99 pelo limite superior do balde que o contém, nunca acima do máximo
+static uint32_t profile_p99(const profile_stats_t *s)
+{
+    uint32_t target = s->count - s->count / 100;
+    uint32_t seen = 0;
+
+    for (int k = 0; k < PROFILE_BUCKETS - 1; ++k)
+    {
+        seen += s->buckets[k];
+        if (seen >= target)
+            return MIN(k ? (1u << k) - 1 : 0, s->max_us);
+    }
+
+    return s->max_us;
+}
+
+void profile_dump(void)
+{
+    printf("etapa          n      min      p99      max  estouros\n");
+    for (int i = 0; i < PROFILE_STAGE_COUNT; ++i)
+    {
+        const profile_stats_t *s = &stats[i];
+        printf("%-10s %6lu %8lu %8lu %8lu %9lu\n", stage_names[i], (unsigned long)s->count,
+               (unsigned long)s->min_us, (unsigned long)profile_p99(s), (unsigned long)s->max_us,
+               (unsigned long)s->overruns);
+    }
+
+    // Histogramas: um balde por potência de 2 em microssegundos, só os não vazios
+    for (int i = 0; i < PROFILE_STAGE_COUNT; ++i)
+    {
+        printf("%-10s", stage_names[i]);
+        for (int k = 0; k < PROFILE_BUCKETS; ++k)
+        {
+            if (!stats[i].buckets[k])
+                continue;
+            if (k == PROFILE_BUCKETS - 1)
+                printf(" >=%lu:%lu", 1ul << (k - 1), (unsigned long)stats[i].buckets[k]);
+            else
+                printf(" <%lu:%lu", 1ul << k, (unsigned long)stats[i].buckets[k]);
+        }
+        printf("\n");
+    }
+}
+
+#endif // PROFILE_ENABLED
@@ -0,0 +1,65 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+
+// Medição do tempo de cada etapa do quadro em histogramas de baldes fixos. Fica
+// ligada por padrão nos builds de depuração e some por completo nos de release
+// (NDEBUG); -DPROFILE_ENABLED=0/1 força uma das opções.
+#ifndef PROFILE_ENABLED
+#ifdef NDEBUG
+#define PROFILE_ENABLED 0
+#else
+#define PROFILE_ENABLED 1
+#endif
+#endif
+
+#define PROFILE_BUCKETS 18 // Balde 0: 0 us; balde k: [2^(k-1), 2^k) us; o último acumula o resto
+
+typedef enum {
+    PROFILE_INPUT,      // Leitura do joystick (núcleo 0)
+    PROFILE_GAME_TICK,  // Lógica do jogo (núcleo 0)
+    PROFILE_PUBLISH,    // Publicação do quadro (núcleo 0)
+    PROFILE_OLED_DRAW,  // Desenho e início do envio do display (núcleo 1)
+    PROFILE_OLED_FLUSH, // Envio do display até o barramento liberar (núcleo 1)
+    PROFILE_MATRIX,     // Composição e início do envio da matriz (núcleo 1)
+    PROFILE_FRAME,      // Da publicação até o quadro chegar ao display (núcleo 1)
+    PROFILE_INPUT_LATENCY, // Do aperto do botão até a matriz começar a exibi-lo (núcleo 1)
+    PROFILE_WAKE_LATENCY,  // Do despertar do modo ocioso até o primeiro quadro no display (núcleo 1)
+    PROFILE_STAGE_COUNT
+} profile_stage_t;
+
+// Cada etapa tem um único escritor; o dump lê sem travar, o que basta para diagnóstico.
+typedef struct {
+    uint32_t count;
+    uint32_t min_us, max_us;
+    uint32_t budget_us; // Execuções acima disso contam como estouro; 0 desliga
+    uint32_t overruns;
+    uint32_t buckets[PROFILE_BUCKETS];
+} profile_stats_t;
+
+#if PROFILE_ENABLED
+
+void profile_set_budget(profile_stage_t stage, uint32_t budget_us);
+void profile_record(profile_stage_t stage, uint32_t duration_us);
+void profile_reset(void);
+void profile_dump(void);
+
+// Cronômetro de escopo: PROFILE_BEGIN e PROFILE_END da mesma etapa no mesmo bloco.
+#define PROFILE_BEGIN(stage) const uint32_t profile_start_##stage = time_us_32()
+#define PROFILE_END(stage) profile_record(stage, time_us_32() - profile_start_##stage)
+
+#else
+
+#define profile_set_budget(stage, budget_us) ((void)0)
+#define profile_record(stage, duration_us) ((void)0)
+#define profile_reset() ((void)0)
+#define profile_dump() ((void)0)
+#define PROFILE_BEGIN(stage) ((void)0)
+#define PROFILE_END(stage) ((void)0)
+
+#endif // PROFILE_ENABLED
+
+#endif // PROFILER_H
@@ -0,0 +1,154 @@
+#include "scheduler.h"
+#include "hardware/sync.h"
+
+static task_t tasks[SCHEDULER_MAX_TASKS];
+
+// Procura uma posição livre na tabela de tarefas.
+static int scheduler_alloc(task_fn_t fn, void *arg, uint32_t period_us)
+{
+    for (int id = 0; id < SCHEDULER_MAX_TASKS; ++id)
+    {
+        if (!tasks[id].active)
+        {
+            tasks[id].fn = fn;
+            tasks[id].arg = arg;
+            tasks[id].period_us = period_us;
+            tasks[id].pending = false;
+            tasks[id].overruns = 0;
+            tasks[id].generation = (tasks[id].generation + 1) & 0x7FFF; // Mantém o id positivo
+            tasks[id].active = true;
+            return id;
+        }
+    }
+    return -1;
+}
+
+// Id entregue a quem registrou a tarefa da posição slot.
+static int scheduler_id(int slot)
+{
+    return slot | tasks[slot].generation << SCHEDULER_SLOT_BITS;
+}
+
+// Tarefa de um id, ou NULL se o id for inválido ou de um uso anterior da posição: uma
+// tarefa de execução única libera a posição ao rodar, e o id guardado por quem a
+// registrou não pode cancelar outra tarefa que reaproveitou a posição.
+static task_t *scheduler_lookup(int id)
+{
+    if (id < 0)
+        return NULL;
+
+    int slot = id & ((1 << SCHEDULER_SLOT_BITS) - 1);
+    if (slot >= SCHEDULER_MAX_TASKS || tasks[slot].generation != id >> SCHEDULER_SLOT_BITS)
+        return NULL;
+    return &tasks[slot];
+}
+
+// Marca a tarefa como pronta e acorda o laço principal.
+static void scheduler_signal(task_t *task)
+{
+    if (task->pending)
+        task->overruns++;
+    task->pending = true;
+    __sev();
+}
+
+// Callback do alarme das tarefas periódicas.
+static bool scheduler_periodic_callback(struct repeating_timer *t)
+{
+    scheduler_signal((task_t *)t->user_data);
+    return true; // Continua repetindo
+}
+
+// Callback do alarme das tarefas de execução única.
+static int64_t scheduler_oneshot_callback(alarm_id_t id, void *user_data)
+{
+    scheduler_signal((task_t *)user_data);
+    return 0; // Não reagenda
+}
+
+// Registra uma tarefa periódica. O período é contado entre inícios consecutivos,
+// então o ritmo não acumula o tempo de execução. Retorna o id ou -1.
+int scheduler_add_periodic(task_fn_t fn, void *arg, uint32_t period_us)
+{
+    int id = scheduler_alloc(fn, arg, period_us);
+    if (id < 0)
+        return -1;
+
+    if (!add_repeating_timer_us(-(int64_t)period_us, scheduler_periodic_callback, &tasks[id], &tasks[id].timer))
+    {
+        tasks[id].active = false;
+        return -1;
+    }
+    return scheduler_id(id);
+}
+
+// Registra uma tarefa que roda uma única vez após o atraso. Retorna o id ou -1.
+int scheduler_add_oneshot(task_fn_t fn, void *arg, uint32_t delay_us)
+{
+    int id = scheduler_alloc(fn, arg, 0);
+    if (id < 0)
+        return -1;
+
+    tasks[id].alarm = add_alarm_in_us(delay_us, scheduler_oneshot_callback, &tasks[id], true);
+    if (tasks[id].alarm < 0)
+    {
+        tasks[id].active = false;
+        return -1;
+    }
+    return scheduler_id(id);
+}
+
+// Cancela uma tarefa. Uma execução já marcada como pronta é descartada.
+void scheduler_cancel(int id)
+{
+    task_t *task = scheduler_lookup(id);
+    if (!task || !task->active)
+        return;
+
+    if (task->period_us)
+        cancel_repeating_timer(&task->timer);
+    else
+        cancel_alarm(task->alarm);
+
+    task->pending = false;
+    task->active = false;
+}
+
+// Quantos disparos da tarefa foram perdidos por ela ainda estar pendente.
+uint32_t scheduler_overruns(int id)
+{
+    task_t *task = scheduler_lookup(id);
+    return task ? task->overruns : 0;
+}
+
+// Executa uma vez cada tarefa pronta. Retorna true se alguma rodou.
+bool scheduler_run_pending(void)
+{
+    bool ran = false;
+
+    for (int id = 0; id < SCHEDULER_MAX_TASKS; ++id)
+    {
+        task_t *task = &tasks[id];
+        if (!task->active || !task->pending)
+            continue;
+
+        task->pending = false;
+        if (task->period_us == 0)
+            task->active = false; // Libera a posição antes de rodar: a tarefa pode se reagendar
+        task->fn(task->arg);
+        ran = true;
+    }
+
+    return ran;
+}
+
+// Laço do escalonador: roda as tarefas prontas e dorme até o próximo alarme.
+// O __sev() dos alarmes garante que um disparo entre a varredura e o __wfe() não se perde.
+void scheduler_run(void)
+{
+    while (true)
+    {
+        if (!scheduler_run_pending())
+            __wfe();
+    }
+}
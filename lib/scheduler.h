@@ -0,0 +1,33 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+
+#define SCHEDULER_MAX_TASKS 12
+#define SCHEDULER_SLOT_BITS 8 // Um id é a posição na tabela mais a geração dela nos bits acima
+
+// Tarefa cooperativa: roda até o fim no laço principal, nunca dentro de interrupção.
+typedef void (*task_fn_t)(void *arg);
+
+typedef struct {
+    task_fn_t fn;
+    void *arg;
+    uint32_t period_us;          // 0 para tarefas de execução única
+    struct repeating_timer timer; // Timer das tarefas periódicas
+    alarm_id_t alarm;            // Alarme das tarefas de execução única
+    volatile bool pending;       // Marcado pelo alarme, consumido pelo laço
+    volatile uint32_t overruns;  // Disparos perdidos porque a execução anterior não terminou
+    uint16_t generation;         // Muda a cada uso da posição: ids antigos deixam de valer
+    bool active;
+} task_t;
+
+int scheduler_add_periodic(task_fn_t fn, void *arg, uint32_t period_us);
+int scheduler_add_oneshot(task_fn_t fn, void *arg, uint32_t delay_us);
+void scheduler_cancel(int id);
+uint32_t scheduler_overruns(int id);
+bool scheduler_run_pending(void);
+void scheduler_run(void);
+
+#endif // SCHEDULER_H
@@ -0,0 +1,79 @@
+#include <string.h>
+
+#include "sprite.h"
+
+// Combina um byte já deslocado com o byte de página do buffer.
+static inline void sprite_apply(uint8_t *dst, uint8_t bits, uint8_t mask, sprite_mode_t mode)
+{
+  switch (mode)
+  {
+  case SPRITE_SET:
+    *dst |= bits;
+    break;
+  case SPRITE_CLEAR:
+    *dst &= ~bits;
+    break;
+  case SPRITE_XOR:
+    *dst ^= bits;
+    break;
+  default:
+    *dst = (*dst & ~mask) | (bits & mask);
+    break;
+  }
+}
+
+// Desenha um quadro do sprite com o canto superior esquerdo em (x, y), recortando nas
+// bordas da tela. Com y fora de um múltiplo de 8, cada byte do sprite é deslocado e
+// dividido entre duas páginas do buffer: no máximo dois bytes tocados por byte do sprite.
+void sprite_draw(ssd1306_t *ssd, const sprite_t *sprite, uint8_t frame, int x, int y, sprite_mode_t mode)
+{
+  const uint8_t pages = SPRITE_PAGES(sprite->height);
+  const int first_page = y >> 3; // Divisão arredondada para baixo, também para y negativo
+  const uint8_t shift = y & 7;
+  int col_start = MAX(0, -x);
+  int col_end = MIN((int)sprite->width, SSD1306_WIDTH - x);
+
+  if (frame >= sprite->frames || col_start >= col_end || y >= SSD1306_HEIGHT || y + sprite->height <= 0)
+    return;
+
+  // Máscara implícita da caixa quando não há máscara: a última página só até height.
+  uint8_t last_mask = sprite->height & 7 ? 0xFF >> (8 - (sprite->height & 7)) : 0xFF;
+  size_t frame_offset = (size_t)frame * sprite->width * pages;
+
+  for (int col = col_start; col < col_end; ++col)
+  {
+    uint8_t *column = &ssd->ram_buffer[1 + (x + col) * SSD1306_PAGES];
+    const uint8_t *data = &sprite->data[frame_offset + (size_t)col * pages];
+    const uint8_t *mask = sprite->mask ? &sprite->mask[frame_offset + (size_t)col * pages] : NULL;
+
+    for (int p = 0; p < pages; ++p)
+    {
+      int page = first_page + p;
+      uint8_t bits = data[p];
+      uint8_t box = mask ? mask[p] : (p == pages - 1 ? last_mask : 0xFF);
+
+      if (page >= 0 && page < SSD1306_PAGES)
+        sprite_apply(&column[page], bits << shift, box << shift, mode);
+      if (shift && page + 1 >= 0 && page + 1 < SSD1306_PAGES)
+        sprite_apply(&column[page + 1], bits >> (8 - shift), box >> (8 - shift), mode);
+    }
+  }
+}
+
+// Converte um bitmap linha a linha (cada linha em (width + 7) / 8 bytes, bit 7 à
+// esquerda) para o formato de páginas do sprite. out precisa de SPRITE_BYTES bytes.
+void sprite_convert_rows(const uint8_t *rows, uint8_t width, uint8_t height, uint8_t *out)
+{
+  const uint8_t pages = SPRITE_PAGES(height);
+  const uint8_t stride = (width + 7) / 8;
+
+  memset(out, 0, SPRITE_BYTES(width, height));
+  for (uint8_t y = 0; y < height; ++y)
+  {
+    for (uint8_t x = 0; x < width; ++x)
+    {
+      if (rows[y * stride + x / 8] & (0x80 >> (x % 8)))
+        out[x * pages + y / 8] |= 1 << (y % 8);
+    }
+  }
+}
@@ -0,0 +1,32 @@
+#ifndef SPRITE_H
+#define SPRITE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ssd1306.h"
+
+// Sprites de 1 bit já no formato do buffer do SSD1306: cada coluna é uma sequência de
+// bytes de página, bit 0 em cima. Os quadros de uma animação ficam em sequência:
+// o byte da página p, coluna x, quadro f está em data[(f * width + x) * pages + p].
+// Bits abaixo de height na última página precisam estar em zero.
+#define SPRITE_PAGES(height) (((height) + 7) / 8)
+#define SPRITE_BYTES(width, height) ((width) * SPRITE_PAGES(height))
+
+typedef enum {
+  SPRITE_SET,    // Acende os pixels do sprite (OR)
+  SPRITE_CLEAR,  // Apaga os pixels do sprite
+  SPRITE_XOR,    // Inverte os pixels do sprite; desenhar de novo restaura o fundo
+  SPRITE_MASKED, // Substitui o fundo onde a máscara vale 1; sem máscara, a caixa toda
+} sprite_mode_t;
+
+typedef struct {
+  uint8_t width, height;
+  uint8_t frames;      // Quadros de animação em data (e em mask)
+  const uint8_t *data;
+  const uint8_t *mask; // Mesmo formato de data; só usada em SPRITE_MASKED, pode ser NULL
+} sprite_t;
+
+void sprite_draw(ssd1306_t *ssd, const sprite_t *sprite, uint8_t frame, int x, int y, sprite_mode_t mode);
+void sprite_convert_rows(const uint8_t *rows, uint8_t width, uint8_t height, uint8_t *out);
+
+#endif // SPRITE_H
@@ -1,75 +1,397 @@
+#include <string.h>
+
 #include "ssd1306.h"
 #include "font.h"
+#include "vector.h"
+
+// Buffers estáticos: sem alocação em tempo de execução.
+static uint8_t ssd1306_ram[SSD1306_BUFSIZE];
+static uint8_t ssd1306_shadow[SSD1306_BUFSIZE - 1];
+static uint16_t ssd1306_tx[SSD1306_TX_WORDS];
 
+// width e height existem por compatibilidade e precisam coincidir com SSD1306_WIDTH e
+// SSD1306_HEIGHT: toda a aritmética de índices usa as constantes de compilação, então
+// outro tamanho para a execução em vez de desenhar fora do painel.
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
-  ssd->width = width;
-  ssd->height = height;
-  ssd->pages = height / 8U;
+  if (width != SSD1306_WIDTH || height != SSD1306_HEIGHT)
+    panic("ssd1306: painel %ux%u, mas o build usa %ux%u (SSD1306_WIDTH/SSD1306_HEIGHT)", width, height,
+          SSD1306_WIDTH, SSD1306_HEIGHT);
+
+  ssd->width = SSD1306_WIDTH;
+  ssd->height = SSD1306_HEIGHT;
+  ssd->pages = SSD1306_PAGES;
   ssd->address = address;
   ssd->i2c_port = i2c;
-  ssd->bufsize = ssd->pages * ssd->width + 1;
-  ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
+  ssd->external_vcc = external_vcc;
+  ssd->bufsize = SSD1306_BUFSIZE;
+  ssd->ram_buffer = ssd1306_ram;
+  memset(ssd->ram_buffer, 0, SSD1306_BUFSIZE);
   ssd->ram_buffer[0] = 0x40;
   ssd->port_buffer[0] = 0x80;
+  ssd->shadow_buffer = ssd1306_shadow;
+  ssd->tx_words = ssd1306_tx;
+  ssd->tx_len = 0;
+  ssd->shadow_valid = false;
+  ssd->bytes_sent = 0;
+  ssd->scrolling = false;
+  ssd->start_line = 0;
+
+  ssd->stream = hal_i2c_stream_init(i2c);
 }
 
 void ssd1306_config(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_DISP | 0x00);
-  ssd1306_command(ssd, SET_MEM_ADDR);
-  ssd1306_command(ssd, 0x01);
-  ssd1306_command(ssd, SET_DISP_START_LINE | 0x00);
-  ssd1306_command(ssd, SET_SEG_REMAP | 0x01);
-  ssd1306_command(ssd, SET_MUX_RATIO);
-  ssd1306_command(ssd, HEIGHT - 1);
-  ssd1306_command(ssd, SET_COM_OUT_DIR | 0x08);
-  ssd1306_command(ssd, SET_DISP_OFFSET);
-  ssd1306_command(ssd, 0x00);
-  ssd1306_command(ssd, SET_COM_PIN_CFG);
-  ssd1306_command(ssd, 0x12);
-  ssd1306_command(ssd, SET_DISP_CLK_DIV);
-  ssd1306_command(ssd, 0x80);
-  ssd1306_command(ssd, SET_PRECHARGE);
-  ssd1306_command(ssd, 0xF1);
-  ssd1306_command(ssd, SET_VCOM_DESEL);
-  ssd1306_command(ssd, 0x30);
-  ssd1306_command(ssd, SET_CONTRAST);
-  ssd1306_command(ssd, 0xFF);
-  ssd1306_command(ssd, SET_ENTIRE_ON);
-  ssd1306_command(ssd, SET_NORM_INV);
-  ssd1306_command(ssd, SET_CHARGE_PUMP);
-  ssd1306_command(ssd, 0x14);
-  ssd1306_command(ssd, SET_DISP | 0x01);
+  const uint8_t init_sequence[] = {
+    SET_DISP | 0x00,
+#if SSD1306_CONTROLLER == SSD1306_CONTROLLER_SSD1306
+    SET_MEM_ADDR, 0x01, // Endereçamento vertical, na ordem do buffer
+#endif
+    SET_DISP_START_LINE | 0x00,
+    SET_SEG_REMAP | 0x01,
+    SET_MUX_RATIO, SSD1306_HEIGHT - 1,
+    SET_COM_OUT_DIR | 0x08,
+    SET_DISP_OFFSET, 0x00,
+    SET_COM_PIN_CFG, SSD1306_HEIGHT == 32 ? 0x02 : 0x12,
+    SET_DISP_CLK_DIV, 0x80,
+    SET_PRECHARGE, ssd->external_vcc ? 0x22 : 0xF1,
+    SET_VCOM_DESEL, 0x30,
+    SET_CONTRAST, 0xFF,
+    SET_ENTIRE_ON,
+    SET_NORM_INV,
+#if SSD1306_CONTROLLER == SSD1306_CONTROLLER_SH1106
+    SH1106_SET_DC_DC, ssd->external_vcc ? 0x8A : 0x8B,
+#else
+    SET_CHARGE_PUMP, ssd->external_vcc ? 0x10 : 0x14,
+#endif
+    SET_DISP | 0x01,
+  };
+
+  ssd1306_command_batch(ssd, init_sequence, sizeof(init_sequence));
 }
 
 void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
+  ssd1306_wait(ssd); // Não intercala com um quadro ainda em trânsito
   ssd->port_buffer[1] = command;
-  i2c_write_blocking(
-    ssd->i2c_port,
-    ssd->address,
-    ssd->port_buffer,
-    2,
-    false
-  );
+  hal_i2c_write(ssd->i2c_port, ssd->address, ssd->port_buffer, 2);
+}
+
+// Calcula o intervalo de colunas alteradas de uma página em relação à cópia do display.
+// Retorna false se a página não mudou.
+static bool ssd1306_page_dirty_span(ssd1306_t *ssd, uint8_t page, uint8_t *col_start, uint8_t *col_end) {
+  const uint8_t *ram = ssd->ram_buffer + 1 + page;
+  const uint8_t *shadow = ssd->shadow_buffer + page;
+  int first = -1, last = -1;
+
+  for (int x = 0; x < SSD1306_WIDTH; ++x) {
+    if (ram[x * SSD1306_PAGES] != shadow[x * SSD1306_PAGES]) {
+      if (first < 0)
+        first = x;
+      last = x;
+    }
+  }
+
+  if (first < 0)
+    return false;
+
+  *col_start = first;
+  *col_end = last;
+  return true;
+}
+
+// Envia vários comandos em uma única transação: um byte de controle com Co=0
+// seguido de todos os bytes de comando.
+void ssd1306_command_batch(ssd1306_t *ssd, const uint8_t *commands, size_t count) {
+  uint8_t buffer[1 + SSD1306_MAX_BATCH];
+
+  ssd1306_wait(ssd); // Não intercala com um quadro ainda em trânsito
+  buffer[0] = 0x00;
+
+  while (count > 0) {
+    size_t chunk = MIN(count, (size_t)SSD1306_MAX_BATCH);
+    memcpy(&buffer[1], commands, chunk);
+    hal_i2c_write(ssd->i2c_port, ssd->address, buffer, chunk + 1);
+    commands += chunk;
+    count -= chunk;
+  }
+}
+
+// Acrescenta uma transação I2C ao quadro em trânsito. O último byte leva o bit de
+// STOP; o controlador gera um novo START sozinho quando há mais dados na FIFO.
+static void ssd1306_queue_transaction(ssd1306_t *ssd, const uint8_t *data, size_t len) {
+  for (size_t i = 0; i < len; ++i)
+    ssd->tx_words[ssd->tx_len++] = data[i];
+  ssd->tx_words[ssd->tx_len - 1] |= HAL_I2C_STOP_BIT;
+  ssd->bytes_sent += len;
+}
+
+// Enfileira uma janela retangular (colunas x páginas) do buffer, gravada na RAM do
+// display a partir da página page_start + ram_page_offset.
+static void ssd1306_queue_window(ssd1306_t *ssd, uint8_t col_start, uint8_t col_end, uint8_t page_start, uint8_t page_end,
+                                 uint8_t ram_page_offset) {
+  uint8_t pages = page_end - page_start + 1;
+
+#if SSD1306_CONTROLLER == SSD1306_CONTROLLER_SH1106
+  // Endereçamento por página: uma janela de comandos e uma transação de dados por
+  // página, percorrendo a linha de bytes da página no buffer organizado por colunas.
+  uint8_t column = col_start + SSD1306_COLUMN_OFFSET;
+  for (uint8_t page = page_start; page <= page_end; ++page) {
+    const uint8_t window[] = {
+      0x00, // Co=0: todos os bytes seguintes são comandos
+      SET_PAGE_START | (page + ram_page_offset),
+      SET_LOW_COLUMN | (column & 0x0F),
+      SET_HIGH_COLUMN | (column >> 4),
+    };
+    ssd1306_queue_transaction(ssd, window, sizeof(window));
+
+    ssd->tx_words[ssd->tx_len++] = ssd->ram_buffer[0];
+    for (uint8_t x = col_start; x <= col_end; ++x)
+      ssd->tx_words[ssd->tx_len++] = ssd->ram_buffer[1 + x * SSD1306_PAGES + page];
+    ssd->tx_words[ssd->tx_len - 1] |= HAL_I2C_STOP_BIT;
+    ssd->bytes_sent += 1 + (size_t)(col_end - col_start + 1);
+  }
+#else
+  const uint8_t window[] = {
+    0x00, // Co=0: todos os bytes seguintes são comandos
+    SET_COL_ADDR, col_start, col_end,
+    SET_PAGE_ADDR, page_start + ram_page_offset, page_end + ram_page_offset,
+  };
+
+  // A janela e os dados seguem em transações consecutivas no mesmo envio por DMA.
+  ssd1306_queue_transaction(ssd, window, sizeof(window));
+
+  // Endereçamento vertical: os dados seguem coluna por coluna, página a página.
+  ssd->tx_words[ssd->tx_len++] = ssd->ram_buffer[0];
+  for (uint8_t x = col_start; x <= col_end; ++x) {
+    size_t offset = (size_t)x * SSD1306_PAGES + page_start;
+    for (uint8_t i = 0; i < pages; ++i)
+      ssd->tx_words[ssd->tx_len++] = ssd->ram_buffer[1 + offset + i];
+  }
+  ssd->tx_words[ssd->tx_len - 1] |= HAL_I2C_STOP_BIT;
+  ssd->bytes_sent += 1 + (size_t)pages * (col_end - col_start + 1);
+#endif
 }
 
+// Enfileira uma janela do buffer e atualiza a cópia do display.
+static void ssd1306_send_window(ssd1306_t *ssd, uint8_t col_start, uint8_t col_end, uint8_t page_start, uint8_t page_end) {
+  uint8_t pages = page_end - page_start + 1;
+
+  ssd1306_queue_window(ssd, col_start, col_end, page_start, page_end, 0);
+#if SSD1306_RAM_COPIES > 1
+  // Com a linha inicial fora do zero a tela também mostra a metade de baixo da RAM
+  if (ssd->start_line != 0)
+    ssd1306_queue_window(ssd, col_start, col_end, page_start, page_end, SSD1306_PAGES);
+#endif
+
+  for (uint8_t x = col_start; x <= col_end; ++x) {
+    size_t offset = (size_t)x * SSD1306_PAGES + page_start;
+    memcpy(&ssd->shadow_buffer[offset], &ssd->ram_buffer[1 + offset], pages);
+  }
+}
+
+// Codifica as regiões alteradas e entrega o quadro ao DMA, retornando em seguida.
+// O buffer pode ser redesenhado logo após a chamada: os dados em trânsito são uma cópia.
+void ssd1306_send_data_async(ssd1306_t *ssd) {
+  ssd1306_wait(ssd); // Só há um quadro em trânsito por vez
+  ssd->tx_len = 0;
+  ssd->bytes_sent = 0;
+
+  // Durante a rolagem por hardware a RAM do display não pode ser escrita; o buffer
+  // segue valendo e vai inteiro quando a rolagem parar.
+  if (ssd->scrolling)
+    return;
+
+  if (!ssd->shadow_valid) {
+    ssd1306_send_window(ssd, 0, SSD1306_WIDTH - 1, 0, SSD1306_PAGES - 1);
+    ssd->shadow_valid = true;
+  } else {
+    // Une páginas consecutivas alteradas em uma única janela enquanto o desperdício
+    // de bytes for menor que o custo de abrir uma nova janela.
+    bool open = false;
+    uint8_t win_start = 0, win_end = 0, win_page = 0;
+    size_t win_used = 0;
+
+    for (uint8_t page = 0; page < SSD1306_PAGES; ++page) {
+      uint8_t col_start, col_end;
+
+      if (!ssd1306_page_dirty_span(ssd, page, &col_start, &col_end)) {
+        if (open)
+          ssd1306_send_window(ssd, win_start, win_end, win_page, page - 1);
+        open = false;
+        continue;
+      }
+
+      if (open) {
+        uint8_t merged_start = MIN(win_start, col_start);
+        uint8_t merged_end = MAX(win_end, col_end);
+        size_t merged_used = win_used + (col_end - col_start + 1);
+        size_t merged_size = (size_t)(merged_end - merged_start + 1) * (page - win_page + 1);
+
+        if (merged_size - merged_used <= SSD1306_WINDOW_OVERHEAD) {
+          win_start = merged_start;
+          win_end = merged_end;
+          win_used = merged_used;
+          continue;
+        }
+
+        ssd1306_send_window(ssd, win_start, win_end, win_page, page - 1);
+      }
+
+      open = true;
+      win_start = col_start;
+      win_end = col_end;
+      win_page = page;
+      win_used = col_end - col_start + 1;
+    }
+
+    if (open)
+      ssd1306_send_window(ssd, win_start, win_end, win_page, SSD1306_PAGES - 1);
+  }
+
+  if (ssd->tx_len == 0)
+    return; // Nada mudou
+
+  hal_i2c_stream_start(ssd->stream, ssd->i2c_port, ssd->address, ssd->tx_words, ssd->tx_len);
+}
+
+// Envia ao display apenas as regiões que mudaram desde o último envio e aguarda o fim.
 void ssd1306_send_data(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_COL_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->width - 1);
-  ssd1306_command(ssd, SET_PAGE_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->pages - 1);
-  i2c_write_blocking(
-    ssd->i2c_port,
-    ssd->address,
-    ssd->ram_buffer,
-    ssd->bufsize,
-    false
-  );
+  ssd1306_send_data_async(ssd);
+  ssd1306_wait(ssd);
+}
+
+// Indica se ainda há um quadro em trânsito.
+bool ssd1306_is_busy(ssd1306_t *ssd) {
+  switch (hal_i2c_stream_status(ssd->stream, ssd->i2c_port)) {
+    case HAL_I2C_BUSY:
+      return true;
+    case HAL_I2C_ABORTED:
+      ssd->shadow_valid = false; // O display pode ter ficado pela metade: reenvia tudo
+      return false;
+    default:
+      return false;
+  }
+}
+
+// Aguarda o fim do quadro em trânsito.
+void ssd1306_wait(ssd1306_t *ssd) {
+  while (ssd1306_is_busy(ssd))
+    tight_loop_contents();
+}
+
+// Faz o fim de cada envio assíncrono gerar um evento no núcleo que chama, para ele
+// poder dormir em __wfe enquanto o quadro está em trânsito.
+void ssd1306_enable_wake(ssd1306_t *ssd) {
+  hal_i2c_stream_enable_wake(ssd->i2c_port);
+}
+
+// Descarta a cópia do display, forçando o próximo envio a ser completo.
+void ssd1306_invalidate(ssd1306_t *ssd) {
+  ssd->shadow_valid = false;
+}
+
+// Prepara a rolagem por hardware: interrompe uma rolagem anterior e garante que a RAM
+// do display tenha o conteúdo atual do buffer, já que ela não pode ser escrita depois.
+static void ssd1306_scroll_prepare(ssd1306_t *ssd) {
+  ssd1306_scroll_stop(ssd);
+  ssd1306_send_data(ssd);
+}
+
+// Rola as páginas page_start..page_end continuamente na horizontal, sem nenhum byte
+// de dados por quadro. Não existe no SH1106: retorna false.
+bool ssd1306_scroll_horizontal(ssd1306_t *ssd, bool left, uint8_t page_start, uint8_t page_end, ssd1306_scroll_interval_t interval) {
+#if SSD1306_CONTROLLER == SSD1306_CONTROLLER_SSD1306
+  if (page_start > page_end || page_end >= SSD1306_PAGES)
+    return false;
+
+  ssd1306_scroll_prepare(ssd);
+
+  const uint8_t commands[] = {
+    left ? SET_HSCROLL_LEFT : SET_HSCROLL_RIGHT, 0x00,
+    page_start, interval, page_end,
+    0x00, 0xFF,
+    SET_SCROLL_ON,
+  };
+  ssd1306_command_batch(ssd, commands, sizeof(commands));
+  ssd->scrolling = true;
+  return true;
+#else
+  return false;
+#endif
+}
+
+// Rolagem diagonal: as páginas page_start..page_end andam na horizontal e a área
+// abaixo das fixed_rows primeiras linhas desce vertical_offset linhas a cada passo.
+// Não existe no SH1106: retorna false.
+bool ssd1306_scroll_diagonal(ssd1306_t *ssd, bool left, uint8_t page_start, uint8_t page_end, ssd1306_scroll_interval_t interval,
+                             uint8_t fixed_rows, uint8_t vertical_offset) {
+#if SSD1306_CONTROLLER == SSD1306_CONTROLLER_SSD1306
+  if (page_start > page_end || page_end >= SSD1306_PAGES || fixed_rows >= SSD1306_HEIGHT)
+    return false;
+
+  ssd1306_scroll_prepare(ssd);
+
+  const uint8_t commands[] = {
+    SET_VSCROLL_AREA, fixed_rows, SSD1306_HEIGHT - fixed_rows,
+    left ? SET_VHSCROLL_LEFT : SET_VHSCROLL_RIGHT, 0x00,
+    page_start, interval, page_end,
+    vertical_offset % (SSD1306_HEIGHT - fixed_rows),
+    SET_SCROLL_ON,
+  };
+  ssd1306_command_batch(ssd, commands, sizeof(commands));
+  ssd->scrolling = true;
+  return true;
+#else
+  return false;
+#endif
+}
+
+// Para a rolagem por hardware. A rolagem horizontal desloca a própria RAM do
+// display, então a cópia deixa de valer e o próximo envio é completo.
+void ssd1306_scroll_stop(ssd1306_t *ssd) {
+  if (!ssd->scrolling)
+    return;
+
+  ssd1306_command(ssd, SET_SCROLL_OFF);
+  ssd->scrolling = false;
+  ssd->shadow_valid = false;
+}
+
+// Rolagem vertical pela linha inicial: a linha line do buffer passa a ser exibida no
+// topo e o resto dá a volta. Custa um único comando e nenhum byte de dados. O buffer
+// continua nas coordenadas da RAM; use ssd1306_screen_to_buffer_y para desenhar numa
+// linha da tela. Em painéis de 32 linhas, a linha é uma das 64 da RAM: ao sair do zero
+// o buffer é enviado inteiro para as duas metades, e daí em diante cada envio as mantém
+// iguais, então a volta continua contínua.
+void ssd1306_set_start_line(ssd1306_t *ssd, uint8_t line) {
+  line %= SSD1306_RAM_ROWS;
+#if SSD1306_RAM_COPIES > 1
+  if (ssd->start_line == 0 && line != 0) {
+    ssd->start_line = line;
+    ssd->shadow_valid = false;
+    ssd1306_send_data(ssd); // A metade de baixo precisa estar pronta antes de aparecer
+  }
+#endif
+  ssd->start_line = line;
+  ssd1306_command(ssd, SET_DISP_START_LINE | ssd->start_line);
+}
+
+// Ajusta o contraste (corrente dos segmentos); o valor inicial é 0xFF. Valores baixos
+// reduzem o consumo do painel sem apagar a imagem.
+void ssd1306_set_contrast(ssd1306_t *ssd, uint8_t contrast) {
+  const uint8_t commands[] = {SET_CONTRAST, contrast};
+  ssd1306_command_batch(ssd, commands, sizeof(commands));
+}
+
+// Linha do buffer que aparece na linha y da tela com a linha inicial atual. Com as duas
+// metades da RAM iguais, a linha r da RAM é a linha r % SSD1306_HEIGHT do buffer.
+uint8_t ssd1306_screen_to_buffer_y(const ssd1306_t *ssd, uint8_t y) {
+  return (y + ssd->start_line) % SSD1306_HEIGHT;
 }
 
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
-  uint16_t index = (y >> 3) + (x << 3) + 1;
+  if (x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT)
+    return;
+
+  uint16_t index = (y >> 3) + x * SSD1306_PAGES + 1;
   uint8_t pixel = (y & 0b111);
   if (value)
     ssd->ram_buffer[index] |= (1 << pixel);
@@ -77,107 +399,191 @@ void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
     ssd->ram_buffer[index] &= ~(1 << pixel);
 }
 
-/*
 void ssd1306_fill(ssd1306_t *ssd, bool value) {
-  uint8_t byte = value ? 0xFF : 0x00;
-  for (uint8_t i = 1; i < ssd->bufsize; ++i)
-    ssd->ram_buffer[i] = byte;
-}*/
+  memset(&ssd->ram_buffer[1], value ? 0xFF : 0x00, SSD1306_BUFSIZE - 1);
+}
 
-void ssd1306_fill(ssd1306_t *ssd, bool value) {
-    // Itera por todas as posições do display
-    for (uint8_t y = 0; y < ssd->height; ++y) {
-        for (uint8_t x = 0; x < ssd->width; ++x) {
-            ssd1306_pixel(ssd, x, y, value);
-        }
-    }
+// Aplica uma máscara a um byte de página: liga ou apaga os bits marcados.
+static inline void ssd1306_apply_mask(uint8_t *byte, uint8_t mask, bool value) {
+  if (value)
+    *byte |= mask;
+  else
+    *byte &= ~mask;
 }
 
-void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
-  for (uint8_t x = left; x < left + width; ++x) {
-    ssd1306_pixel(ssd, x, top, value);
-    ssd1306_pixel(ssd, x, top + height - 1, value);
+// Preenche as linhas y0..y1 (já recortadas) de uma coluna: máscara na página do topo,
+// bytes inteiros nas páginas do meio e máscara na página de baixo.
+static void ssd1306_column_span(uint8_t *column, int y0, int y1, bool value) {
+  int first_page = y0 >> 3;
+  int last_page = y1 >> 3;
+  uint8_t top_mask = 0xFF << (y0 & 7);
+  uint8_t bottom_mask = 0xFF >> (7 - (y1 & 7));
+
+  if (first_page == last_page) {
+    ssd1306_apply_mask(&column[first_page], top_mask & bottom_mask, value);
+    return;
   }
-  for (uint8_t y = top; y < top + height; ++y) {
-    ssd1306_pixel(ssd, left, y, value);
-    ssd1306_pixel(ssd, left + width - 1, y, value);
+
+  ssd1306_apply_mask(&column[first_page], top_mask, value);
+  if (last_page - first_page > 1)
+    memset(&column[first_page + 1], value ? 0xFF : 0x00, last_page - first_page - 1);
+  ssd1306_apply_mask(&column[last_page], bottom_mask, value);
+}
+
+// Preenche um retângulo com recorte nas bordas da tela. As máscaras de página são
+// calculadas uma vez e aplicadas a cada coluna; retângulos que cobrem a altura toda
+// viram um único memset, pois o buffer é organizado por colunas.
+void ssd1306_fill_rect(ssd1306_t *ssd, int x, int y, int width, int height, bool value) {
+  int x0 = MAX(x, 0);
+  int y0 = MAX(y, 0);
+  int x1 = MIN(x + width, (int)SSD1306_WIDTH) - 1;
+  int y1 = MIN(y + height, (int)SSD1306_HEIGHT) - 1;
+
+  if (x0 > x1 || y0 > y1)
+    return;
+
+  if (y0 == 0 && y1 == SSD1306_HEIGHT - 1) {
+    memset(&ssd->ram_buffer[1 + x0 * SSD1306_PAGES], value ? 0xFF : 0x00, (size_t)(x1 - x0 + 1) * SSD1306_PAGES);
+    return;
   }
 
-  if (fill) {
-    for (uint8_t x = left + 1; x < left + width - 1; ++x) {
-      for (uint8_t y = top + 1; y < top + height - 1; ++y) {
-        ssd1306_pixel(ssd, x, y, value);
-      }
-    }
+  int first_page = y0 >> 3;
+  int last_page = y1 >> 3;
+  uint8_t top_mask = 0xFF << (y0 & 7);
+  uint8_t bottom_mask = 0xFF >> (7 - (y1 & 7));
+  uint8_t fill = value ? 0xFF : 0x00;
+
+  if (first_page == last_page)
+    top_mask &= bottom_mask;
+
+  uint8_t *column = &ssd->ram_buffer[1 + x0 * SSD1306_PAGES];
+  for (int col = x0; col <= x1; ++col, column += SSD1306_PAGES) {
+    ssd1306_apply_mask(&column[first_page], top_mask, value);
+    if (first_page == last_page)
+      continue;
+    for (int page = first_page + 1; page < last_page; ++page)
+      column[page] = fill;
+    ssd1306_apply_mask(&column[last_page], bottom_mask, value);
   }
 }
 
-void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value) {
-    int dx = abs(x1 - x0);
-    int dy = abs(y1 - y0);
+// Linha horizontal com recorte: um único bit por coluna, na mesma página.
+void ssd1306_hspan(ssd1306_t *ssd, int x0, int x1, int y, bool value) {
+  if (x0 > x1) {
+    int tmp = x0;
+    x0 = x1;
+    x1 = tmp;
+  }
+  if (y < 0 || y >= SSD1306_HEIGHT)
+    return;
+  x0 = MAX(x0, 0);
+  x1 = MIN(x1, SSD1306_WIDTH - 1);
+  if (x0 > x1)
+    return;
 
-    int sx = (x0 < x1) ? 1 : -1;
-    int sy = (y0 < y1) ? 1 : -1;
+  uint8_t mask = 1 << (y & 7);
+  uint8_t *byte = &ssd->ram_buffer[1 + x0 * SSD1306_PAGES + (y >> 3)];
+  for (int x = x0; x <= x1; ++x, byte += SSD1306_PAGES)
+    ssd1306_apply_mask(byte, mask, value);
+}
 
-    int err = dx - dy;
+// Linha vertical com recorte: bytes contíguos de uma coluna.
+void ssd1306_vspan(ssd1306_t *ssd, int x, int y0, int y1, bool value) {
+  if (y0 > y1) {
+    int tmp = y0;
+    y0 = y1;
+    y1 = tmp;
+  }
+  if (x < 0 || x >= SSD1306_WIDTH)
+    return;
+  y0 = MAX(y0, 0);
+  y1 = MIN(y1, SSD1306_HEIGHT - 1);
+  if (y0 > y1)
+    return;
 
-    while (true) {
-        ssd1306_pixel(ssd, x0, y0, value); // Desenha o pixel atual
+  ssd1306_column_span(&ssd->ram_buffer[1 + x * SSD1306_PAGES], y0, y1, value);
+}
 
-        if (x0 == x1 && y0 == y1) break; // Termina quando alcança o ponto final
+void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
+  if (width == 0 || height == 0)
+    return;
 
-        int e2 = err * 2;
+  if (fill) {
+    ssd1306_fill_rect(ssd, left, top, width, height, value);
+    return;
+  }
 
-        if (e2 > -dy) {
-            err -= dy;
-            x0 += sx;
-        }
+  int right = left + width - 1;
+  int bottom = top + height - 1;
+  ssd1306_hspan(ssd, left, right, top, value);
+  ssd1306_hspan(ssd, left, right, bottom, value);
+  ssd1306_vspan(ssd, left, top, bottom, value);
+  ssd1306_vspan(ssd, right, top, bottom, value);
+}
 
-        if (e2 < dx) {
-            err += dx;
-            y0 += sy;
-        }
-    }
+// Linha com recorte nas bordas; desenhada em spans por vector_line.
+void ssd1306_line(ssd1306_t *ssd, int x0, int y0, int x1, int y1, bool value) {
+  vector_line(ssd, x0, y0, x1, y1, value);
 }
 
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value) {
-  for (uint8_t x = x0; x <= x1; ++x)
-    ssd1306_pixel(ssd, x, y, value);
+  ssd1306_hspan(ssd, x0, x1, y, value);
 }
 
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
-  for (uint8_t y = y0; y <= y1; ++y)
-    ssd1306_pixel(ssd, x, y, value);
+  ssd1306_vspan(ssd, x, y0, y1, value);
 }
 
-// Função para desenhar um caractere
-void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
+// Copia um glifo 8x8 para o buffer. O font[] já está organizado por colunas, um
+// byte por página: com y múltiplo de 8 cada coluna é um único byte; caso contrário
+// o byte é deslocado e dividido entre duas páginas.
+static void ssd1306_blit_glyph(ssd1306_t *ssd, const uint8_t *glyph, int x, int y)
 {
-  uint16_t index = 0;
-  char ver=c;
-
-  if (c >= 'A' && c <= 'Z') {
-    index = (c - 'A' + 11) * 8; // Letras maiúsculas
-  } else if (c >= '0' && c <= '9') {
-      index = (c - '0' + 1) * 8;  // Números
-  } else if (c >= 'a' && c <= 'z') {
-      index = (c - 'a' + 37) * 8; // Letras minúsculas
-    } else if (c == '%') {          // Caractere '%'
-        index = 63 * 8;             // Índice 63
-  } else if (c == 0xB0) {          // Caractere '°'
-      index = 64 * 8;             // Índice 64
-  } else if (c == ':') {          // Caractere ':'
-      index = 65 * 8;             // Índice 65
-  } 
-
-  for (uint8_t i = 0; i < 8; ++i)
+  int page = y >> 3;
+  uint8_t shift = y & 7;
+  uint8_t low_mask = 0xFF << shift;
+  uint8_t high_mask = ~low_mask;
+  bool low_visible = page >= 0 && page < SSD1306_PAGES;
+  bool high_visible = shift != 0 && page + 1 >= 0 && page + 1 < SSD1306_PAGES;
+
+  for (int i = 0; i < 8; ++i)
   {
-    uint8_t line = font[index + i];
-    for (uint8_t j = 0; j < 8; ++j)
+    int col = x + i;
+    if (col < 0 || col >= SSD1306_WIDTH)
+      continue;
+
+    uint8_t *column = &ssd->ram_buffer[1 + col * SSD1306_PAGES];
+    if (shift == 0)
     {
-      ssd1306_pixel(ssd, x + i, y + j, line & (1 << j));
+      if (low_visible)
+        column[page] = glyph[i];
+      continue;
     }
+
+    if (low_visible)
+      column[page] = (column[page] & ~low_mask) | (uint8_t)(glyph[i] << shift);
+    if (high_visible)
+      column[page + 1] = (column[page + 1] & ~high_mask) | (glyph[i] >> (8 - shift));
+  }
+}
+
+// Função para desenhar um caractere
+void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
+{
+  ssd1306_blit_glyph(ssd, &font[font_glyph_index[(uint8_t)c] * 8], x, y);
+}
+
+// Avança a posição do cursor de texto, quebrando a linha quando o próximo caractere
+// não cabe inteiro. Retorna false quando o texto sai da tela.
+static bool ssd1306_text_advance(uint8_t *x, uint8_t *y)
+{
+  *x += 8;
+  if (*x + 8 > SSD1306_WIDTH)
+  {
+    *x = 0;
+    *y += 8;
   }
+  return *y + 8 <= SSD1306_HEIGHT;
 }
 
 // Função para desenhar uma string
@@ -186,15 +592,56 @@ void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y)
   while (*str)
   {
     ssd1306_draw_char(ssd, *str++, x, y);
-    x += 8;
-    if (x + 8 >= ssd->width)
+    if (!ssd1306_text_advance(&x, &y))
     {
-      x = 0;
-      y += 8;
+      break;
     }
-    if (y + 8 >= ssd->height)
+  }
+}
+
+// Inicializa um campo de texto redesenhado por diferença.
+void ssd1306_text_init(ssd1306_text_t *text, uint8_t x, uint8_t y)
+{
+  text->x = x;
+  text->y = y;
+  text->length = 0;
+  text->valid = false;
+}
+
+// Força o próximo ssd1306_draw_string_cached a redesenhar todos os caracteres.
+void ssd1306_text_invalidate(ssd1306_text_t *text)
+{
+  text->valid = false;
+}
+
+// Desenha uma string redesenhando apenas os caracteres que mudaram desde a última
+// chamada com o mesmo campo. A região do texto não pode ser apagada entre as chamadas;
+// caso seja, use ssd1306_text_invalidate.
+void ssd1306_draw_string_cached(ssd1306_t *ssd, ssd1306_text_t *text, const char *str)
+{
+  uint8_t x = text->x;
+  uint8_t y = text->y;
+  uint8_t i = 0;
+  bool visible = true;
+
+  for (; visible && *str && i < SSD1306_TEXT_MAX; ++i)
+  {
+    char c = *str++;
+    if (!text->valid || i >= text->length || text->chars[i] != c)
     {
-      break;
+      ssd1306_draw_char(ssd, c, x, y);
+      text->chars[i] = c;
     }
+    visible = ssd1306_text_advance(&x, &y);
   }
+
+  // Apaga o que sobrou de uma string anterior mais longa.
+  for (uint8_t j = i; visible && text->valid && j < text->length; ++j)
+  {
+    ssd1306_draw_char(ssd, ' ', x, y);
+    visible = ssd1306_text_advance(&x, &y);
+  }
+
+  text->length = i;
+  text->valid = true;
 }
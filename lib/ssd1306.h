@@ -2,11 +2,61 @@
 #define SSD1306_H
 
 #include <stdlib.h>
-#include "pico/stdlib.h"
-#include "hardware/i2c.h"
+#include "hal.h"
 
-#define WIDTH 128
-#define HEIGHT 64
+// Geometria e controlador fixados em tempo de compilação; troque com -D no build.
+// Variantes suportadas: SSD1306 128x64 (padrão), SSD1306 128x32 e SH1106 128x64, que
+// tem 132 colunas de RAM com a imagem visível a partir da coluna 2 e só aceita
+// endereçamento por página.
+#define SSD1306_CONTROLLER_SSD1306 0
+#define SSD1306_CONTROLLER_SH1106 1
+
+#ifndef SSD1306_CONTROLLER
+#define SSD1306_CONTROLLER SSD1306_CONTROLLER_SSD1306
+#endif
+#ifndef SSD1306_WIDTH
+#define SSD1306_WIDTH 128
+#endif
+#ifndef SSD1306_HEIGHT
+#define SSD1306_HEIGHT 64
+#endif
+
+#if SSD1306_HEIGHT != 64 && SSD1306_HEIGHT != 32
+#error "SSD1306_HEIGHT precisa ser 64 ou 32"
+#endif
+#if SSD1306_WIDTH > 128
+#error "SSD1306_WIDTH precisa ser no máximo 128"
+#endif
+
+#if SSD1306_CONTROLLER == SSD1306_CONTROLLER_SH1106
+#define SSD1306_COLUMN_OFFSET 2 // Primeira coluna visível na RAM do SH1106
+#else
+#define SSD1306_COLUMN_OFFSET 0
+#endif
+
+#define SSD1306_PAGES (SSD1306_HEIGHT / 8)
+#define SSD1306_BUFSIZE (SSD1306_WIDTH * SSD1306_PAGES + 1) // Byte de controle + imagem
+
+#define WIDTH SSD1306_WIDTH
+#define HEIGHT SSD1306_HEIGHT
+
+#define SSD1306_MAX_BATCH 32
+#define SSD1306_TEXT_MAX 32
+
+// Custo aproximado, em bytes no barramento, de abrir uma nova janela de escrita
+// (endereço, byte de controle e 6 comandos de endereçamento, mais START/STOP).
+// Janelas vizinhas são unidas quando o desperdício de dados for menor que isso.
+#define SSD1306_WINDOW_OVERHEAD 10
+
+// Palavras de 16 bits do fluxo I2C (IC_DATA_CMD no RP2040): o byte de dados e, no
+// último byte de cada transação, o bit de STOP. O pior caso é uma janela por
+// página (transação de até 7 bytes de comando + byte de controle dos dados) mais
+// todos os bytes de dados.
+// Em painéis de 32 linhas a RAM do controlador tem 64: com a linha inicial fora do zero,
+// o buffer é espelhado nas duas metades e cada janela vai duas vezes.
+#define SSD1306_RAM_ROWS 64
+#define SSD1306_RAM_COPIES (SSD1306_RAM_ROWS / SSD1306_HEIGHT)
+#define SSD1306_TX_WORDS ((SSD1306_BUFSIZE + SSD1306_PAGES * 8) * SSD1306_RAM_COPIES)
 
 typedef enum {
   SET_CONTRAST = 0x81,
@@ -25,9 +75,35 @@ typedef enum {
   SET_DISP_CLK_DIV = 0xD5,
   SET_PRECHARGE = 0xD9,
   SET_VCOM_DESEL = 0xDB,
-  SET_CHARGE_PUMP = 0x8D
+  SET_CHARGE_PUMP = 0x8D,
+  SET_PAGE_START = 0xB0,     // Endereçamento por página: página atual
+  SET_LOW_COLUMN = 0x00,     // Endereçamento por página: 4 bits baixos da coluna
+  SET_HIGH_COLUMN = 0x10,    // Endereçamento por página: 4 bits altos da coluna
+  SH1106_SET_DC_DC = 0xAD,   // SH1106: controle do conversor interno (no lugar da bomba de carga)
+  SET_HSCROLL_RIGHT = 0x26,  // Rolagem horizontal contínua (SSD1306)
+  SET_HSCROLL_LEFT = 0x27,
+  SET_VHSCROLL_RIGHT = 0x29, // Rolagem diagonal contínua (SSD1306)
+  SET_VHSCROLL_LEFT = 0x2A,
+  SET_VSCROLL_AREA = 0xA3,   // Linhas fixas no topo e linhas que rolam na diagonal
+  SET_SCROLL_OFF = 0x2E,
+  SET_SCROLL_ON = 0x2F
 } ssd1306_command_t;
 
+// Intervalo entre passos da rolagem por hardware, em quadros do display. Os valores
+// são os códigos do controlador.
+typedef enum {
+  SSD1306_SCROLL_2_FRAMES = 0x07,
+  SSD1306_SCROLL_3_FRAMES = 0x04,
+  SSD1306_SCROLL_4_FRAMES = 0x05,
+  SSD1306_SCROLL_5_FRAMES = 0x00,
+  SSD1306_SCROLL_25_FRAMES = 0x06,
+  SSD1306_SCROLL_64_FRAMES = 0x01,
+  SSD1306_SCROLL_128_FRAMES = 0x02,
+  SSD1306_SCROLL_256_FRAMES = 0x03
+} ssd1306_scroll_interval_t;
+
+// Estado do display. Os buffers são estáticos, dimensionados pela geometria de
+// compilação: há uma única instância por programa.
 typedef struct {
   uint8_t width, height, pages, address;
   i2c_inst_t *i2c_port;
@@ -35,20 +111,56 @@ typedef struct {
   uint8_t *ram_buffer;
   size_t bufsize;
   uint8_t port_buffer[2];
+  uint8_t *shadow_buffer; // Cópia do que o display já exibe
+  uint16_t *tx_words;     // Quadro em trânsito, codificado para o DMA do I2C
+  size_t tx_len;          // Palavras válidas em tx_words
+  int stream;             // Fluxo assíncrono do I2C (canal DMA no RP2040)
+  bool shadow_valid;      // false força o envio do quadro completo
+  size_t bytes_sent;      // Bytes enviados pelo último ssd1306_send_data
+  bool scrolling;         // Rolagem por hardware ativa: a RAM do display não pode ser escrita
+  uint8_t start_line;     // Linha da RAM exibida no topo da tela (0 a SSD1306_RAM_ROWS - 1)
 } ssd1306_t;
 
+// Campo de texto que guarda o último conteúdo desenhado para redesenhar só o que mudou.
+typedef struct {
+  uint8_t x, y;
+  uint8_t length;
+  bool valid;
+  char chars[SSD1306_TEXT_MAX];
+} ssd1306_text_t;
+
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
 void ssd1306_config(ssd1306_t *ssd);
 void ssd1306_command(ssd1306_t *ssd, uint8_t command);
+void ssd1306_command_batch(ssd1306_t *ssd, const uint8_t *commands, size_t count);
 void ssd1306_send_data(ssd1306_t *ssd);
+void ssd1306_send_data_async(ssd1306_t *ssd);
+bool ssd1306_is_busy(ssd1306_t *ssd);
+void ssd1306_wait(ssd1306_t *ssd);
+void ssd1306_invalidate(ssd1306_t *ssd);
+void ssd1306_enable_wake(ssd1306_t *ssd);
+
+bool ssd1306_scroll_horizontal(ssd1306_t *ssd, bool left, uint8_t page_start, uint8_t page_end, ssd1306_scroll_interval_t interval);
+bool ssd1306_scroll_diagonal(ssd1306_t *ssd, bool left, uint8_t page_start, uint8_t page_end, ssd1306_scroll_interval_t interval,
+                             uint8_t fixed_rows, uint8_t vertical_offset);
+void ssd1306_scroll_stop(ssd1306_t *ssd);
+void ssd1306_set_start_line(ssd1306_t *ssd, uint8_t line);
+void ssd1306_set_contrast(ssd1306_t *ssd, uint8_t contrast);
+uint8_t ssd1306_screen_to_buffer_y(const ssd1306_t *ssd, uint8_t y);
 
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value);
 void ssd1306_fill(ssd1306_t *ssd, bool value);
 void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill);
-void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value);
+void ssd1306_line(ssd1306_t *ssd, int x0, int y0, int x1, int y1, bool value);
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value);
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value);
+void ssd1306_fill_rect(ssd1306_t *ssd, int x, int y, int width, int height, bool value);
+void ssd1306_hspan(ssd1306_t *ssd, int x0, int x1, int y, bool value);
+void ssd1306_vspan(ssd1306_t *ssd, int x, int y0, int y1, bool value);
 void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y);
 void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
+void ssd1306_text_init(ssd1306_text_t *text, uint8_t x, uint8_t y);
+void ssd1306_text_invalidate(ssd1306_text_t *text);
+void ssd1306_draw_string_cached(ssd1306_t *ssd, ssd1306_text_t *text, const char *str);
 
 #endif
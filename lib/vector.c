@@ -0,0 +1,271 @@
+#include <stdlib.h>
+
+#include "vector.h"
+
+// Códigos de região do Cohen–Sutherland
+#define OUT_LEFT 1
+#define OUT_RIGHT 2
+#define OUT_TOP 4
+#define OUT_BOTTOM 8
+
+static uint8_t vector_outcode(int x, int y) {
+  uint8_t code = 0;
+
+  if (x < 0)
+    code |= OUT_LEFT;
+  else if (x >= SSD1306_WIDTH)
+    code |= OUT_RIGHT;
+  if (y < 0)
+    code |= OUT_TOP;
+  else if (y >= SSD1306_HEIGHT)
+    code |= OUT_BOTTOM;
+  return code;
+}
+
+// Recorta o segmento à tela (Cohen–Sutherland). Retorna false se nada sobra visível.
+bool vector_clip_line(int *x0, int *y0, int *x1, int *y1) {
+  uint8_t code0 = vector_outcode(*x0, *y0);
+  uint8_t code1 = vector_outcode(*x1, *y1);
+
+  while (code0 | code1) {
+    if (code0 & code1)
+      return false;
+
+    // Move para a borda o ponto que está fora; o produto em 64 bits evita estouro
+    // com coordenadas grandes
+    uint8_t code = code0 ? code0 : code1;
+    int64_t dx = *x1 - *x0;
+    int64_t dy = *y1 - *y0;
+    int x, y;
+
+    if (code & OUT_TOP) {
+      y = 0;
+      x = *x0 + (int)(dx * (y - *y0) / dy);
+    } else if (code & OUT_BOTTOM) {
+      y = SSD1306_HEIGHT - 1;
+      x = *x0 + (int)(dx * (y - *y0) / dy);
+    } else if (code & OUT_LEFT) {
+      x = 0;
+      y = *y0 + (int)(dy * (x - *x0) / dx);
+    } else {
+      x = SSD1306_WIDTH - 1;
+      y = *y0 + (int)(dy * (x - *x0) / dx);
+    }
+
+    if (code == code0) {
+      *x0 = x;
+      *y0 = y;
+      code0 = vector_outcode(x, y);
+    } else {
+      *x1 = x;
+      *y1 = y;
+      code1 = vector_outcode(x, y);
+    }
+  }
+  return true;
+}
+
+// Aplica a máscara de bits ao byte de página: liga ou apaga.
+static inline void vector_apply(uint8_t *byte, uint8_t mask, bool value) {
+  if (value)
+    *byte |= mask;
+  else
+    *byte &= ~mask;
+}
+
+// Bresenham sobre o segmento já recortado. Linhas retas viram um único span. Nas
+// outras, os pixels seguidos na mesma coluna e página (linha mais vertical) são
+// acumulados numa máscara e gravados de uma vez; na linha mais horizontal cada coluna
+// recebe um bit e o ponteiro anda uma coluna por passo. Nada é checado por pixel,
+// pois o recorte garante que o segmento todo está na tela.
+void vector_line(ssd1306_t *ssd, int x0, int y0, int x1, int y1, bool value) {
+  if (!vector_clip_line(&x0, &y0, &x1, &y1))
+    return;
+
+  if (y0 == y1) {
+    ssd1306_hspan(ssd, x0, x1, y0, value);
+    return;
+  }
+  if (x0 == x1) {
+    ssd1306_vspan(ssd, x0, y0, y1, value);
+    return;
+  }
+
+  // Desenha sempre de cima para baixo: o passo vertical só avança bits e páginas
+  if (y0 > y1) {
+    int tmp = x0;
+    x0 = x1;
+    x1 = tmp;
+    tmp = y0;
+    y0 = y1;
+    y1 = tmp;
+  }
+
+  int dx = abs(x1 - x0);
+  int dy = y1 - y0;
+  int column_step = x0 < x1 ? SSD1306_PAGES : -SSD1306_PAGES;
+  uint8_t *byte = &ssd->ram_buffer[1 + x0 * SSD1306_PAGES + (y0 >> 3)];
+  uint8_t bit = 1 << (y0 & 7);
+
+  if (dx >= dy) {
+    int err = dx / 2;
+    for (int i = 0; i <= dx; ++i) {
+      vector_apply(byte, bit, value);
+      byte += column_step;
+      err -= dy;
+      if (err < 0) {
+        err += dx;
+        bit <<= 1;
+        if (!bit) {
+          bit = 1;
+          ++byte;
+        }
+      }
+    }
+  } else {
+    int err = dy / 2;
+    uint8_t mask = 0;
+    for (int i = 0; i <= dy; ++i) {
+      mask |= bit;
+      bit <<= 1;
+      err -= dx;
+      if (i == dy || err < 0 || !bit) {
+        vector_apply(byte, mask, value);
+        mask = 0;
+      }
+      if (!bit) {
+        bit = 1;
+        ++byte;
+      }
+      if (err < 0) {
+        err += dy;
+        byte += column_step;
+      }
+    }
+  }
+}
+
+// Liga os pontos em sequência; com closed, fecha do último de volta ao primeiro.
+void vector_polyline(ssd1306_t *ssd, const vector_point_t *points, size_t count, bool closed, bool value) {
+  if (count == 0)
+    return;
+  if (count == 1) {
+    vector_line(ssd, points[0].x, points[0].y, points[0].x, points[0].y, value);
+    return;
+  }
+
+  for (size_t i = 1; i < count; ++i)
+    vector_line(ssd, points[i - 1].x, points[i - 1].y, points[i].x, points[i].y, value);
+  if (closed && count > 2)
+    vector_line(ssd, points[count - 1].x, points[count - 1].y, points[0].x, points[0].y, value);
+}
+
+// Círculo do ponto médio percorrendo o primeiro octante (x de 0 até y). Os pontos com o
+// mesmo y formam um trecho [start, x] que, espelhado, vira spans horizontais no topo e
+// na base e spans verticais nas laterais. No preenchido, cada x do octante vira uma
+// coluna cheia de altura 2y e cada trecho, a coluna cx ± y de altura 2x: spans
+// verticais, que no buffer por colunas são bytes inteiros.
+static void vector_circle_runs(ssd1306_t *ssd, int cx, int cy, int r, bool value, bool fill) {
+  if (r < 0)
+    return;
+
+  int x = 0;
+  int y = r;
+  int d = 1 - r;
+  int start = 0;
+
+  while (x <= y) {
+    int next_x = x + 1;
+    int next_y = y;
+
+    if (d < 0) {
+      d += 2 * x + 3;
+    } else {
+      d += 2 * (x - y) + 5;
+      --next_y;
+    }
+
+    if (fill) {
+      ssd1306_vspan(ssd, cx + x, cy - y, cy + y, value);
+      ssd1306_vspan(ssd, cx - x, cy - y, cy + y, value);
+    }
+
+    if (next_y != y || next_x > next_y) {
+      if (fill) {
+        ssd1306_vspan(ssd, cx + y, cy - x, cy + x, value);
+        ssd1306_vspan(ssd, cx - y, cy - x, cy + x, value);
+      } else {
+        ssd1306_hspan(ssd, cx + start, cx + x, cy - y, value);
+        ssd1306_hspan(ssd, cx - x, cx - start, cy - y, value);
+        ssd1306_hspan(ssd, cx + start, cx + x, cy + y, value);
+        ssd1306_hspan(ssd, cx - x, cx - start, cy + y, value);
+        ssd1306_vspan(ssd, cx + y, cy + start, cy + x, value);
+        ssd1306_vspan(ssd, cx + y, cy - x, cy - start, value);
+        ssd1306_vspan(ssd, cx - y, cy + start, cy + x, value);
+        ssd1306_vspan(ssd, cx - y, cy - x, cy - start, value);
+      }
+      start = next_x;
+    }
+
+    x = next_x;
+    y = next_y;
+  }
+}
+
+void vector_circle(ssd1306_t *ssd, int cx, int cy, int r, bool value) {
+  vector_circle_runs(ssd, cx, cy, r, value, false);
+}
+
+void vector_fill_circle(ssd1306_t *ssd, int cx, int cy, int r, bool value) {
+  vector_circle_runs(ssd, cx, cy, r, value, true);
+}
+
+// y da reta (xa, ya)-(xb, yb) na coluna x, arredondado; xa != xb.
+static int vector_edge_y(int xa, int ya, int xb, int yb, int x) {
+  int64_t num = (int64_t)(yb - ya) * (x - xa);
+  int64_t den = xb - xa;
+
+  return ya + (int)(num >= 0 ? (num + den / 2) / den : -((-num + den / 2) / den));
+}
+
+// Triângulo preenchido coluna a coluna: com os vértices ordenados por x, cada coluna
+// vai da aresta longa (0-2) até a aresta 0-1 ou 1-2. Só as colunas visíveis são
+// percorridas.
+void vector_fill_triangle(ssd1306_t *ssd, int x0, int y0, int x1, int y1, int x2, int y2, bool value) {
+  int tmp;
+
+#define VECTOR_SWAP(a, b) (tmp = (a), (a) = (b), (b) = tmp)
+  if (x0 > x1) {
+    VECTOR_SWAP(x0, x1);
+    VECTOR_SWAP(y0, y1);
+  }
+  if (x1 > x2) {
+    VECTOR_SWAP(x1, x2);
+    VECTOR_SWAP(y1, y2);
+  }
+  if (x0 > x1) {
+    VECTOR_SWAP(x0, x1);
+    VECTOR_SWAP(y0, y1);
+  }
+#undef VECTOR_SWAP
+
+  if (x0 == x2) {
+    ssd1306_vspan(ssd, x0, MIN(y0, MIN(y1, y2)), MAX(y0, MAX(y1, y2)), value);
+    return;
+  }
+
+  int first = MAX(x0, 0);
+  int last = MIN(x2, SSD1306_WIDTH - 1);
+  for (int x = first; x <= last; ++x) {
+    int ya = vector_edge_y(x0, y0, x2, y2, x);
+    int yb;
+
+    if (x < x1)
+      yb = vector_edge_y(x0, y0, x1, y1, x);
+    else if (x1 < x2)
+      yb = vector_edge_y(x1, y1, x2, y2, x);
+    else
+      yb = y1; // Aresta 1-2 vertical na última coluna; ya já está em y2
+    ssd1306_vspan(ssd, x, ya, yb, value);
+  }
+}
@@ -0,0 +1,23 @@
+#ifndef VECTOR_H
+#define VECTOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ssd1306.h"
+
+// Primitivas vetoriais sobre o buffer do SSD1306. Todas aceitam coordenadas fora da
+// tela: a linha é recortada antes de ser desenhada e o resto vira spans horizontais e
+// verticais (ssd1306_hspan/ssd1306_vspan), que também recortam.
+
+typedef struct {
+  int16_t x, y;
+} vector_point_t;
+
+bool vector_clip_line(int *x0, int *y0, int *x1, int *y1);
+void vector_line(ssd1306_t *ssd, int x0, int y0, int x1, int y1, bool value);
+void vector_polyline(ssd1306_t *ssd, const vector_point_t *points, size_t count, bool closed, bool value);
+void vector_circle(ssd1306_t *ssd, int cx, int cy, int r, bool value);
+void vector_fill_circle(ssd1306_t *ssd, int cx, int cy, int r, bool value);
+void vector_fill_triangle(ssd1306_t *ssd, int x0, int y0, int x1, int y1, int x2, int y2, bool value);
+
+#endif // VECTOR_H
@@ -1,39 +1,178 @@
+#include <string.h>
+#include <math.h>
+
+#include "hardware/sync.h"
+
 #include "ws2812b.h"
-#include "led_matrix.pio.h"
 
 ws2812b_LED_t led_matrix[LED_MATRIX_COUNT];
-PIO led_matrix_pio;
-uint sm;
+uint16_t led_matrix_transmit[LED_MATRIX_COUNT];
+
+static uint32_t led_matrix_words[LED_MATRIX_COUNT]; // Pixels em trânsito, um por palavra (GRB nos bits 31 a 8).
+static ws2812b_frame_t last_frame = 0;              // Último quadro enviado.
+static volatile ws2812b_frame_t done_frame = 0;     // Último quadro já travado nos LEDs.
+static bool led_matrix_sent = false;                // led_matrix_words reflete o que os LEDs exibem.
+static const uint8_t led_panel_rotations[LED_PANEL_COUNT] = LED_PANEL_ROTATIONS;
+static alarm_pool_t *led_alarm_pool;                // Alarmes da matriz, no núcleo de ws2812b_init.
+
+#if LED_STRIPS > 1
+// Fatias de bits para a saída paralela: 24 bytes por LED, cada um com o mesmo bit de
+// todas as fitas (bit k = fita k), na ordem em que a máquina PIO os envia: G, R e B,
+// cada um do bit 7 para o 0.
+#define WS2812B_SLICE_WORDS (24 / 4)
+static uint32_t led_matrix_slices[LED_STRIP_LEDS * WS2812B_SLICE_WORDS];
+#endif
+
+// Curvas de gama em ponto fixo 8.8, na ordem de envio: G, R e B.
+static uint16_t led_gamma[3][256];
+static uint8_t led_brightness = WS2812B_BRIGHTNESS;
+
+#if WS2812B_DITHER
+// Níveis 8.8 na ordem da fita, em dois buffers: o timer lê o da frente enquanto
+// ws2812b_present prepara o outro. O resto fracionário de cada canal fica em led_error.
+static uint16_t led_levels[2][LED_MATRIX_COUNT][3];
+static uint8_t led_error[LED_MATRIX_COUNT][3];
+static volatile uint8_t levels_front = 0;
+static volatile ws2812b_frame_t pending_frame = 0; // Último quadro publicado por ws2812b_present.
+static ws2812b_frame_t shown_frame = 0;            // Quadro no buffer da frente.
+static ws2812b_frame_t sent_frame = 0;             // Quadro do último envio, travado no próximo tique.
+static struct repeating_timer refresh_timer;
+static bool refresh_running = false;
+#endif
+
+// Gira (x, y) em uma área width x height por rotation passos de 90° no sentido horário.
+static void ws2812b_rotate(uint *x, uint *y, uint width, uint height, uint rotation)
+{
+    uint rx, ry;
+
+    switch (rotation & 3)
+    {
+    case 1:
+        rx = height - 1 - *y;
+        ry = *x;
+        break;
+    case 2:
+        rx = width - 1 - *x;
+        ry = height - 1 - *y;
+        break;
+    case 3:
+        rx = *y;
+        ry = width - 1 - *x;
+        break;
+    default:
+        return;
+    }
+
+    *x = rx;
+    *y = ry;
+}
+
+// Índice na fita de um LED dentro de um painel, nas coordenadas do próprio painel.
+static uint ws2812b_panel_index(uint x, uint y)
+{
+    uint line, position, line_length;
 
-// Inicializa a máquina PIO para controle da matriz de LEDs.
+    if (LED_PANEL_COLUMN_MAJOR)
+    {
+        line = x;
+        position = y;
+        line_length = LED_PANEL_HEIGHT;
+    }
+    else
+    {
+        line = y;
+        position = x;
+        line_length = LED_PANEL_WIDTH;
+    }
+
+    // Com serpentina, as linhas ímpares voltam no sentido contrário.
+    if (LED_PANEL_SERPENTINE && line % 2)
+        position = line_length - 1 - position;
+    return line * line_length + position;
+}
+
+// Calcula o índice na fita de uma coordenada lógica: espelha e gira a matriz, acha o
+// painel na cadeia e aplica a rotação e o caminho da fita do painel.
+static uint ws2812b_map_xy(uint x, uint y)
+{
+    if (LED_MATRIX_FLIP_X)
+        x = LED_MATRIX_LOGICAL_WIDTH - 1 - x;
+    if (LED_MATRIX_FLIP_Y)
+        y = LED_MATRIX_LOGICAL_HEIGHT - 1 - y;
+    ws2812b_rotate(&x, &y, LED_MATRIX_LOGICAL_WIDTH, LED_MATRIX_LOGICAL_HEIGHT, LED_MATRIX_ROTATION);
+
+    uint panel_x = x / LED_PANEL_WIDTH, panel_y = y / LED_PANEL_HEIGHT;
+    uint local_x = x % LED_PANEL_WIDTH, local_y = y % LED_PANEL_HEIGHT;
+
+    if (LED_PANELS_SERPENTINE && panel_y % 2)
+        panel_x = LED_PANELS_X - 1 - panel_x;
+    uint panel = panel_y * LED_PANELS_X + panel_x;
+
+    ws2812b_rotate(&local_x, &local_y, LED_PANEL_WIDTH, LED_PANEL_HEIGHT, led_panel_rotations[panel]);
+    return panel * LED_PANEL_LEDS + ws2812b_panel_index(local_x, local_y);
+}
+
+#if WS2812B_DITHER
+static bool ws2812b_refresh_callback(struct repeating_timer *timer);
+#endif
+
+// Inicializa a máquina PIO para controle da matriz de LEDs. Os alarmes da matriz (o
+// travamento de cada quadro e o timer do dithering) ficam num pool próprio, criado no
+// núcleo que chama: é nele que as interrupções rodam, então a matriz deve ser iniciada
+// no núcleo que desenha, e não no do jogo.
 void ws2812b_init(uint pin)
 {
+    static const float gamma[3] = {WS2812B_GAMMA_G, WS2812B_GAMMA_R, WS2812B_GAMMA_B};
 
-    // Cria programa PIO.
-    uint offset = pio_add_program(pio0, &led_matrix_program);
-    led_matrix_pio = pio0;
+    hal_ws2812_init(pin);
+    led_alarm_pool = alarm_pool_create_with_unused_hardware_alarm(2);
 
-    // Toma posse de uma máquina PIO.
-    sm = pio_claim_unused_sm(led_matrix_pio, false);
-    if (sm < 0)
+    // Tabelas de gama: 255 vira 255.0 (0xFF00), o maior nível que o dithering envia.
+    for (int c = 0; c < 3; ++c)
     {
-        led_matrix_pio = pio1;
-        sm = pio_claim_unused_sm(led_matrix_pio, true); // Se nenhuma máquina estiver livre, panic!
+        for (int v = 0; v < 256; ++v)
+        {
+            led_gamma[c][v] = (uint16_t)(powf(v / 255.0f, gamma[c]) * 0xFF00 + 0.5f);
+        }
     }
 
-    // Inicia programa na máquina PIO obtida.
-    led_matrix_program_init(led_matrix_pio, sm, offset, pin, 800000.f);
+    // Pré-calcula a ordem de envio: para cada posição na fita, o pixel lógico que ela exibe.
+    for (uint y = 0; y < LED_MATRIX_LOGICAL_HEIGHT; ++y)
+    {
+        for (uint x = 0; x < LED_MATRIX_LOGICAL_WIDTH; ++x)
+        {
+            led_matrix_transmit[ws2812b_map_xy(x, y)] = y * LED_MATRIX_LOGICAL_WIDTH + x;
+        }
+    }
 
     // Limpa buffer de pixels.
+    ws2812b_clear();
+
+#if WS2812B_DITHER
+    // Restos iniciais espalhados, para LEDs com a mesma cor não piscarem em fase.
     for (uint i = 0; i < LED_MATRIX_COUNT; ++i)
     {
-        led_matrix[i].R = 0;
-        led_matrix[i].G = 0;
-        led_matrix[i].B = 0;
+        for (int c = 0; c < 3; ++c)
+            led_error[i][c] = (i * 97 + c * 53) & 0xFF;
     }
+
+    ws2812b_resume();
+#endif
 }
 
-// Atribui uma cor RGB a um LED.
+// Ajusta o brilho global (0 a 255, linear), aplicado a partir do próximo ws2812b_present.
+void ws2812b_set_brightness(uint8_t brightness)
+{
+    led_brightness = brightness;
+}
+
+// Nível 8.8 de um canal: curva de gama seguida do brilho global.
+static inline uint16_t ws2812b_level(int channel, uint8_t value)
+{
+    return (uint32_t)led_gamma[channel][value] * led_brightness / 255;
+}
+
+// Atribui uma cor RGB a um pixel do framebuffer lógico (y * LED_MATRIX_LOGICAL_WIDTH + x).
 void ws2812b_set_led(const uint index, const uint8_t r, const uint8_t g, const uint8_t b)
 {
     led_matrix[index].R = r;
@@ -41,24 +180,251 @@ void ws2812b_set_led(const uint index, const uint8_t r, const uint8_t g, const u
     led_matrix[index].B = b;
 }
 
+// Atribui uma cor RGB ao LED na coordenada lógica (x, y).
+void ws2812b_set_led_xy(const uint x, const uint y, const uint8_t r, const uint8_t g, const uint8_t b)
+{
+    ws2812b_set_led(y * LED_MATRIX_LOGICAL_WIDTH + x, r, g, b);
+}
+
 // Limpa o buffer de pixels.
 void ws2812b_clear()
 {
-    for (uint i = 0; i < LED_MATRIX_COUNT; ++i)
-        ws2812b_set_led(i, 0, 0, 0);
+    memset(led_matrix, 0, sizeof(led_matrix));
 }
 
-// Escreve os dados do buffer nos LEDs.
+// Escreve os dados do buffer nos LEDs e aguarda o sinal de RESET.
 void ws2812b_write()
 {
-    // Escreve cada dado de 8-bits dos pixels em sequência no buffer da máquina PIO.
+    ws2812b_wait(ws2812b_present());
+}
+
+#if LED_STRIPS > 1
+// Monta as fatias de bits a partir das palavras na ordem da cadeia. Para cada LED e cada
+// byte de cor, os bytes das 8 fitas formam uma matriz 8x8 de bits (linha = fita) que é
+// transposta com trocas de blocos 1x1, 2x2 e 4x4: as metades lo (fitas 0 a 3) e hi
+// (fitas 4 a 7) cabem em registradores de 32 bits, sem aritmética de 64 bits.
+static void ws2812b_transpose(const uint32_t *words, uint32_t *slices)
+{
+    for (uint led = 0; led < LED_STRIP_LEDS; ++led, slices += WS2812B_SLICE_WORDS)
+    {
+        for (uint shift = 24; shift >= 8; shift -= 8)
+        {
+            uint32_t lo = 0, hi = 0, t;
+
+            for (uint strip = 0; strip < LED_STRIPS; ++strip)
+            {
+                uint32_t byte = (words[strip * LED_STRIP_LEDS + led] >> shift) & 0xFF;
+                if (strip < 4)
+                    lo |= byte << (8 * strip);
+                else
+                    hi |= byte << (8 * (strip - 4));
+            }
+
+            t = (lo ^ (lo >> 7)) & 0x00AA00AA;
+            lo ^= t ^ (t << 7);
+            t = (hi ^ (hi >> 7)) & 0x00AA00AA;
+            hi ^= t ^ (t << 7);
+            t = (lo ^ (lo >> 14)) & 0x0000CCCC;
+            lo ^= t ^ (t << 14);
+            t = (hi ^ (hi >> 14)) & 0x0000CCCC;
+            hi ^= t ^ (t << 14);
+            t = (lo ^ (hi << 4)) & 0xF0F0F0F0;
+            lo ^= t;
+            hi ^= t >> 4;
+
+            // Byte b agora guarda o bit b de cada fita: bits 0 a 3 em lo, 4 a 7 em hi.
+            // Os LEDs esperam o bit 7 primeiro, então a ordem das fatias é invertida.
+            slices[(24 - shift) / 4] = __builtin_bswap32(hi);
+            slices[(24 - shift) / 4 + 1] = __builtin_bswap32(lo);
+        }
+    }
+}
+#endif
+
+// Inicia o envio de led_matrix_words, já na ordem da cadeia.
+static void ws2812b_send(void)
+{
+#if LED_STRIPS > 1
+    ws2812b_transpose(led_matrix_words, led_matrix_slices);
+    hal_ws2812_start(led_matrix_slices, count_of(led_matrix_slices));
+#else
+    hal_ws2812_start(led_matrix_words, LED_MATRIX_COUNT);
+#endif
+}
+
+#if WS2812B_DITHER
+// Tique do timer, a cada WS2812B_REFRESH_US. O envio do tique anterior já terminou,
+// então o quadro dele está travado. Troca para o último quadro publicado, soma o nível
+// de cada canal ao resto acumulado, envia a parte inteira e guarda a fração. São só
+// somas e máscaras por canal (mais a transposição, com fitas em paralelo); a matriz só
+// é reenviada se alguma palavra mudar.
+static bool ws2812b_refresh_callback(struct repeating_timer *timer)
+{
+    ws2812b_frame_t latched = done_frame;
+    done_frame = sent_frame;
+
+    if (pending_frame != shown_frame)
+    {
+        shown_frame = pending_frame;
+        __dmb(); // Lê os níveis só depois de observar o quadro publicado
+        levels_front ^= 1;
+    }
+
+    const uint16_t (*levels)[3] = led_levels[levels_front];
+    bool changed = !led_matrix_sent;
+    for (uint i = 0; i < LED_MATRIX_COUNT; ++i)
+    {
+        uint32_t word = 0;
+        for (int c = 0; c < 3; ++c)
+        {
+            uint16_t sum = led_error[i][c] + levels[i][c];
+            led_error[i][c] = sum & 0xFF;
+            word |= (uint32_t)(sum >> 8) << (24 - 8 * c);
+        }
+        changed |= word != led_matrix_words[i];
+        led_matrix_words[i] = word;
+    }
+
+    if (changed)
+    {
+        ws2812b_send();
+        led_matrix_sent = true;
+        sent_frame = shown_frame;
+    }
+    else
+    {
+        // Os LEDs já exibem este quadro
+        sent_frame = shown_frame;
+        done_frame = shown_frame;
+    }
+    if (done_frame != latched)
+        __sev(); // Acorda quem espera um quadro travado
+    return true;
+}
+
+// Converte o framebuffer em níveis 8.8 no buffer de trás e o publica para o timer, que
+// passa a usá-lo no próximo tique. Se o quadro anterior ainda não foi travado, aguarda:
+// só então o timer largou o buffer de trás. Um quadro igual ao anterior não é publicado.
+ws2812b_frame_t ws2812b_present()
+{
+    ws2812b_wait(last_frame);
+
+    uint16_t (*back)[3] = led_levels[levels_front ^ 1];
+    const uint16_t (*front)[3] = led_levels[levels_front];
+    bool changed = last_frame == 0;
+
+    // A tabela de envio já dá o pixel lógico de cada LED da fita.
     for (uint i = 0; i < LED_MATRIX_COUNT; ++i)
     {
-        pio_sm_put_blocking(led_matrix_pio, sm, led_matrix[i].G);
-        pio_sm_put_blocking(led_matrix_pio, sm, led_matrix[i].R);
-        pio_sm_put_blocking(led_matrix_pio, sm, led_matrix[i].B);
+        const ws2812b_LED_t *led = &led_matrix[led_matrix_transmit[i]];
+        back[i][0] = ws2812b_level(0, led->G);
+        back[i][1] = ws2812b_level(1, led->R);
+        back[i][2] = ws2812b_level(2, led->B);
+        changed |= memcmp(back[i], front[i], sizeof(back[i])) != 0;
     }
-    sleep_us(100); // Espera 100us, sinal de RESET do datasheet.
+
+    if (!changed)
+        return last_frame;
+
+    __dmb(); // Os níveis precisam estar visíveis antes do novo quadro
+    pending_frame = ++last_frame;
+    return last_frame;
+}
+#else
+// Chamado pelo alarme quando o último bit saiu e o tempo de RESET passou.
+static int64_t ws2812b_latch_callback(alarm_id_t id, void *user_data)
+{
+    done_frame = (ws2812b_frame_t)(uintptr_t)user_data;
+    __sev(); // Acorda quem espera o quadro travado
+    return 0;
+}
+
+// Envia o buffer aos LEDs por DMA e retorna em seguida. O fim do quadro, incluindo o
+// RESET, é marcado por um alarme de hardware. Se o quadro anterior ainda estiver em
+// trânsito, aguarda ele terminar antes de reutilizar o buffer de envio. Um quadro
+// idêntico ao último enviado não é transmitido.
+ws2812b_frame_t ws2812b_present()
+{
+    bool changed = !led_matrix_sent;
+
+    ws2812b_wait(last_frame);
+
+    // A máquina desloca para a esquerda a partir do bit 31: G sai primeiro, depois R e B,
+    // cada um do bit mais significativo para o menos, como os LEDs esperam.
+    // O buffer de envio ainda guarda o último quadro, então a comparação é feita aqui.
+    // A tabela de envio já dá o pixel lógico de cada LED da fita.
+    for (uint i = 0; i < LED_MATRIX_COUNT; ++i)
+    {
+        const ws2812b_LED_t *led = &led_matrix[led_matrix_transmit[i]];
+        uint32_t word = (uint32_t)((ws2812b_level(0, led->G) + 0x80) >> 8) << 24 |
+                        (uint32_t)((ws2812b_level(1, led->R) + 0x80) >> 8) << 16 |
+                        (uint32_t)((ws2812b_level(2, led->B) + 0x80) >> 8) << 8;
+        changed |= word != led_matrix_words[i];
+        led_matrix_words[i] = word;
+    }
+
+    if (!changed)
+        return last_frame;
+    led_matrix_sent = true;
+
+    ws2812b_frame_t frame = ++last_frame;
+    ws2812b_send();
+    if (alarm_pool_add_alarm_in_us(led_alarm_pool, WS2812B_FRAME_US, ws2812b_latch_callback, (void *)(uintptr_t)frame, true) < 0)
+    {
+        // Sem alarmes livres: volta ao comportamento bloqueante.
+        sleep_us(WS2812B_FRAME_US);
+        done_frame = frame;
+    }
+
+    return frame;
+}
+#endif
+
+// Último quadro entregue por ws2812b_present.
+ws2812b_frame_t ws2812b_last_frame()
+{
+    return last_frame;
+}
+
+// Indica se o quadro já foi enviado e travado nos LEDs.
+bool ws2812b_is_done(ws2812b_frame_t frame)
+{
+    return (int32_t)(done_frame - frame) >= 0;
+}
+
+// Aguarda o quadro ser enviado e travado nos LEDs.
+void ws2812b_wait(ws2812b_frame_t frame)
+{
+    while (!ws2812b_is_done(frame))
+    {
+        tight_loop_contents();
+    }
+}
+
+// Apaga os LEDs e, com dithering, para o timer de atualização: a CPU deixa de acordar
+// a cada tique. Aguarda o quadro apagado ser travado. Até ws2812b_resume, nada deve ser
+// enviado à matriz.
+void ws2812b_suspend()
+{
+    ws2812b_clear();
+    ws2812b_write();
+#if WS2812B_DITHER
+    if (refresh_running)
+        cancel_repeating_timer(&refresh_timer);
+    refresh_running = false;
+#endif
+}
+
+// Retoma o timer de atualização parado por ws2812b_suspend.
+void ws2812b_resume()
+{
+#if WS2812B_DITHER
+    if (refresh_running)
+        return;
+    // Nunca mais rápido que o envio de um quadro: o tique seguinte pressupõe o anterior travado.
+    int64_t period_us = WS2812B_REFRESH_US > WS2812B_FRAME_US ? WS2812B_REFRESH_US : WS2812B_FRAME_US;
+    refresh_running = alarm_pool_add_repeating_timer_us(led_alarm_pool, -period_us, ws2812b_refresh_callback, NULL, &refresh_timer);
+#endif
 }
 
 // Desenha um número na matriz de LEDs.
@@ -77,11 +443,15 @@ void ws2812b_draw_number(uint8_t number_index)
 
     // Desenha o número na matriz de LEDs.
     printf("Desenhando número %d\n", number_index);
-    for (int i = 0; i < LED_MATRIX_COUNT; i++)
+    // O desenho está na ordem da fita de um painel 5x5 em serpentina.
+    for (int i = 0; i < LED_NUMBER_LEDS; i++)
     {
         if (led_matrix_numbers[number_index][i] != 0)
         {
-            ws2812b_set_led(i, r, g, b);
+            uint y = i / LED_NUMBER_SIZE;
+            uint x = y % 2 ? LED_NUMBER_SIZE - 1 - i % LED_NUMBER_SIZE : i % LED_NUMBER_SIZE;
+            if (x < LED_MATRIX_LOGICAL_WIDTH && y < LED_MATRIX_LOGICAL_HEIGHT)
+                ws2812b_set_led_xy(x, y, r, g, b);
         }
     }
 
@@ -3,8 +3,8 @@
 
 #include <stdlib.h>
 #include <stdio.h>
-#include "hardware/pio.h"
-#include "pico/stdlib.h"
+#include "hal.h"
+#include "led_matrix_geometry.h"
 #include "led_matrix_numbers.h"
 
 // Tipos de dados.
@@ -14,15 +14,51 @@ struct pixel_t
 };
 typedef struct pixel_t pixel_t;
 typedef pixel_t ws2812b_LED_t; // Mudança de nome de "struct pixel_t" para "ws2812bLED_t" por clareza.
+typedef uint32_t ws2812b_frame_t; // Identificador de um quadro enviado, usado para aguardar ou consultar o envio.
 
-extern ws2812b_LED_t led_matrix[LED_MATRIX_COUNT]; // Declaração do buffer de pixels que formam a matriz.
-extern PIO led_matrix_pio;                     // Ponteiro para a máquina PIO.
-extern uint sm;                        // Número da máquina state machine.
+#define WS2812B_RESET_US 100 // Tempo em nível baixo para os LEDs travarem os dados.
+#define WS2812B_LED_US 30    // 24 bits a 800 kHz por LED.
+#define WS2812B_FRAME_US (LED_STRIP_LEDS * WS2812B_LED_US + WS2812B_RESET_US) // Envio de um quadro inteiro.
+
+// As cores do framebuffer são perceptuais (0-255): no envio passam pela curva de gama
+// de cada canal e pelo brilho global. Com WS2812B_DITHER, o resultado fica em ponto fixo
+// 8.8 e um timer reenvia a matriz a cada WS2812B_REFRESH_US, acumulando a fração de cada
+// LED entre os envios (dithering temporal): cores fracas ganham níveis entre os degraus
+// de 8 bits. Sem WS2812B_DITHER, o valor é arredondado e enviado uma vez.
+#ifndef WS2812B_DITHER
+#define WS2812B_DITHER 1
+#endif
+#ifndef WS2812B_REFRESH_US
+#define WS2812B_REFRESH_US 2500 // 400 Hz; nunca menos que WS2812B_FRAME_US
+#endif
+#ifndef WS2812B_GAMMA_R
+#define WS2812B_GAMMA_R 2.2f
+#endif
+#ifndef WS2812B_GAMMA_G
+#define WS2812B_GAMMA_G 2.2f
+#endif
+#ifndef WS2812B_GAMMA_B
+#define WS2812B_GAMMA_B 2.2f
+#endif
+#ifndef WS2812B_BRIGHTNESS
+#define WS2812B_BRIGHTNESS 16 // Brilho inicial, de 0 a 255 (escala linear)
+#endif
+
+extern ws2812b_LED_t led_matrix[LED_MATRIX_COUNT];  // Framebuffer lógico, linha a linha a partir de (0, 0).
+extern uint16_t led_matrix_transmit[LED_MATRIX_COUNT]; // Tabela posição na fita -> pixel do framebuffer.
 
 void ws2812b_init(uint pin);
 void ws2812b_set_led(const uint index, const uint8_t r, const uint8_t g, const uint8_t b);
+void ws2812b_set_led_xy(const uint x, const uint y, const uint8_t r, const uint8_t g, const uint8_t b);
+void ws2812b_set_brightness(uint8_t brightness);
 void ws2812b_clear();
 void ws2812b_write();
+ws2812b_frame_t ws2812b_present();
+ws2812b_frame_t ws2812b_last_frame();
+bool ws2812b_is_done(ws2812b_frame_t frame);
+void ws2812b_wait(ws2812b_frame_t frame);
+void ws2812b_suspend();
+void ws2812b_resume();
 void ws2812b_draw_number(uint8_t index);
 
 #endif // WS2812B_H